@@ -112,8 +112,10 @@ int simulatePageFaultsFIFO(const vector<MemoryReference>& memoryTrace, int numFr
 
 int simulatePageFaultsLRU(const vector<MemoryReference>& memoryTrace, int numFrames)
 {
-    unordered_map<string, MemoryMapping> pageTable;
-    vector<string> frameStack;
+    // El stack es una lista (la menos reciente al frente) y cada pagina residente guarda su posicion
+    // en ella, asi un acierto la mueve al final en O(1) sin buscarla
+    unordered_map<string, pair<MemoryMapping, list<string>::iterator>> pageTable;
+    list<string> frameStack;
     int pageFaults = 0;
 
     for (const MemoryReference& reference : memoryTrace)
@@ -121,17 +123,17 @@ int simulatePageFaultsLRU(const vector<MemoryReference>& memoryTrace, int numFra
         string address = reference.address;
         string page = address.substr(0, address.length() - 3); // Obtener la pgina (primeros dgitos de la direccin)
 
-        if (pageTable.find(page) == pageTable.end())
+        auto it = pageTable.find(page);
+        if (it == pageTable.end())
         {
             // Page fault: la pgina no est en memoria
             pageFaults++;
 
-            if (frameStack.size() >= numFrames)
+            if (frameStack.size() >= (size_t)numFrames)
             {
                 // Se debe reemplazar una pgina usando LRU
-                string pageToRemove = frameStack.front();
-                frameStack.erase(frameStack.begin());
-                pageTable.erase(pageToRemove);
+                pageTable.erase(frameStack.front());
+                frameStack.pop_front();
             }
 
             // Agregar la nueva pgina a la tabla y al stack de marcos
@@ -139,73 +141,81 @@ int simulatePageFaultsLRU(const vector<MemoryReference>& memoryTrace, int numFra
             mapping.page = page;
             mapping.frame = to_string(frameStack.size());
             mapping.dirty = (reference.operation == 'W');
-            pageTable[page] = mapping;
             frameStack.push_back(page);
+            pageTable[page] = make_pair(mapping, prev(frameStack.end()));
         }
         else
         {
-            // La pgina ya est en memoria, actualizar su posicin en el stack
-            auto it = find(frameStack.begin(), frameStack.end(), page);
-            frameStack.erase(it);
-            frameStack.push_back(page);
+            // La pgina ya est en memoria, moverla al final del stack
+            frameStack.splice(frameStack.end(), frameStack, it->second.second);
         }
     }
 
     return pageFaults;
 }
 
-int simulatePageFaultsOPT(const vector<MemoryReference>& memoryTrace, const unordered_map<string, MemoryMapping>& physicalMemoryMap, int numFrames)
+int simulatePageFaultsOPT(const vector<MemoryReference>& memoryTrace, int numFrames)
 {
-    unordered_map<string, int> pageAccessCount; // Contador de accesos a cada pgina
-    int pageFaults = 0;
+    // Version exacta de OPT: pre-pass hacia atras con el proximo uso de cada referencia y
+    // un max-heap de paginas residentes por proximo uso (misma estrategia que manejomemoriafinal.cpp)
+    vector<string> pages(memoryTrace.size());
+    for (size_t i = 0; i < memoryTrace.size(); i++)
+    {
+        const string& address = memoryTrace[i].address;
+        pages[i] = address.substr(0, address.length() - 3);
+    }
 
-    for (int i = 0; i < memoryTrace.size(); i++)
+    vector<size_t> nextUse(memoryTrace.size());
+    unordered_map<string, size_t> lastSeen;
+    for (size_t i = memoryTrace.size(); i-- > 0;)
     {
-        string address = memoryTrace[i].address;
-        string page = address.substr(0, address.length() - 3); // Obtener la pgina (primeros dgitos de la direccin)
+        auto it = lastSeen.find(pages[i]);
+        nextUse[i] = (it == lastSeen.end()) ? memoryTrace.size() : it->second;
+        lastSeen[pages[i]] = i;
+    }
 
-        if (pageAccessCount.find(page) == pageAccessCount.end())
-        {
-            // Pgina no registrada, inicializar contador
-            pageAccessCount[page] = 0;
-        }
+    unordered_map<string, size_t> pageTable; // Pagina residente -> indice de su proximo uso
+    priority_queue<pair<size_t, string>> nextUseHeap;
+    int pageFaults = 0;
 
-        if (i >= numFrames && pageAccessCount.size() >= numFrames)
+    for (size_t i = 0; i < memoryTrace.size(); i++)
+    {
+        auto it = pageTable.find(pages[i]);
+
+        if (it == pageTable.end())
         {
-            // Page fault: la pgina no est en memoria
+            // Page fault: la pagina no esta en memoria
             pageFaults++;
 
-            // Encontrar la pgina ms lejana en el futuro para reemplazarla
-            string pageToRemove;
-            int maxDistance = -1;
-
-            for (const auto& entry : pageAccessCount)
+            if (pageTable.size() >= (size_t)numFrames)
             {
-                string currentPage = entry.first;
-                int currentDistance = memoryTrace.size(); // Valor inicial alto para asegurar que se actualice en el siguiente bucle
-
-                for (int j = i + 1; j < memoryTrace.size(); j++)
+                // Reemplazar la pagina de uso mas lejano; las entradas viejas del heap se descartan
+                while (true)
                 {
-                    if (memoryTrace[j].address.substr(0, memoryTrace[j].address.length() - 3) == currentPage)
-                    {
-                        currentDistance = j;
-                        break;
-                    }
-                }
-
-                if (currentDistance > maxDistance)
-                {
-                    maxDistance = currentDistance;
-                    pageToRemove = currentPage;
+                    auto top = pageTable.find(nextUseHeap.top().second);
+                    if (top != pageTable.end() && top->second == nextUseHeap.top().first) break;
+                    nextUseHeap.pop();
                 }
+                pageTable.erase(nextUseHeap.top().second);
+                nextUseHeap.pop();
             }
 
-            // Eliminar la pgina seleccionada de la tabla
-            auto it = pageAccessCount.find(pageToRemove);
-            pageAccessCount.erase(it);
+            pageTable[pages[i]] = nextUse[i];
+        }
+        else
+        {
+            it->second = nextUse[i];
         }
+        nextUseHeap.push(make_pair(nextUse[i], pages[i]));
 
-        pageAccessCount[page]++;
+        // Compactar el heap cuando las entradas viejas dominan, para mantenerlo en O(frames)
+        if (nextUseHeap.size() > 2 * pageTable.size() + 64)
+        {
+            vector<pair<size_t, string>> live;
+            live.reserve(pageTable.size());
+            for (const auto& entry : pageTable) live.push_back(make_pair(entry.second, entry.first));
+            nextUseHeap = priority_queue<pair<size_t, string>>(less<pair<size_t, string>>(), move(live));
+        }
     }
 
     return pageFaults;
@@ -284,7 +294,7 @@ int main()
         cout << "Simulacin OPT para " << numFrames << " frames:" << endl;
         unordered_map<string, MemoryMapping> physicalMemoryMapOPT;
         generatePhysicalMemoryMap(memoryTrace, physicalMemoryMapOPT, numFrames);
-        int pageFaultsOPT = simulatePageFaultsOPT(memoryTrace, physicalMemoryMapOPT, numFrames);
+        int pageFaultsOPT = simulatePageFaultsOPT(memoryTrace, numFrames);
         printSummary(physicalMemoryMapOPT, memoryTrace, pageFaultsOPT, numFrames);
         cout << endl;
     }
@@ -9,327 +9,3887 @@
 #include <vector>
 #include <bitset>
 #include <cmath>
+#include <cassert>
 #include <algorithm> 
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define TRACE_BLOCK_SCAN // Lineas del trace de a bloques de 64 bytes con SSE2/AVX2
+#endif
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 using namespace std;
 
+const int PAGE_OFFSET_BITS = 12; // 4 KiB: pagina base con la que se cargan y convierten los traces
+
 struct MemoryReference
 {
-    string address;
+    uint64_t address; // Direccion ya convertida desde hexadecimal al cargar el trace
+    uint64_t page;    // Numero de pagina calculado una sola vez al cargar el trace
     char operation;
 };
 
+struct PageTableEntry;
+
+// Marco ocupado: los bits de sucia y referenciada viven en la PTE de la pagina
 struct MemoryMapping
 {
-    string page;
-    string frame;
-    bool dirty;
+    uint64_t page;
+    int frame;
+    PageTableEntry *entry; // Las hojas de RadixPageTable no se mueven: el puntero es estable
+    bool prefetched;       // Traida por readahead y todavia sin usar
 };
 
-void generatePhysicalMemoryMap(const vector<MemoryReference> &physicalMemoryTrace, 
-unordered_map<string, MemoryMapping> &physicalMemoryMap, int numFrames)
+// Entrada de la tabla de paginas empaquetada en 32 bits: marco, presente, sucia y referenciada
+struct PageTableEntry
 {
-    int nextFrame = 0;
+    static const uint32_t FRAME_MASK = (1u << 28) - 1;
+    static const uint32_t PRESENT = 1u << 28;
+    static const uint32_t DIRTY = 1u << 29;
+    static const uint32_t REFERENCED = 1u << 30;
+
+    uint32_t bits = 0;
+
+    bool present() const { return bits & PRESENT; }
+    bool dirty() const { return bits & DIRTY; }
+    bool referenced() const { return bits & REFERENCED; }
+    int frame() const { return bits & FRAME_MASK; }
 
-    for (const MemoryReference &reference : physicalMemoryTrace)
+    void map(int frame, bool write)
     {
-        string address = reference.address;
-        string page = address.substr(0, address.length() - 3); // Obtener la página (primeros dígitos de la dirección)
+        assert(frame >= 0 && (uint32_t)frame <= FRAME_MASK); // El campo de marco tiene 28 bits
+        bits = PRESENT | REFERENCED | ((uint32_t)frame & FRAME_MASK) | (write ? DIRTY : 0);
+    }
 
-        if (physicalMemoryMap.find(page) == physicalMemoryMap.end())
-        {
-            // La página aún no ha sido asignada a un marco
-            MemoryMapping mapping;
-            mapping.page = ""; // No se utiliza en el mapa de memoria física
-            mapping.frame = nextFrame;
-            mapping.dirty = (reference.operation == 'W');
-            physicalMemoryMap[page] = mapping;
+    void touch(bool write)
+    {
+        bits |= REFERENCED | (write ? DIRTY : 0);
+    }
+
+    void clearReferenced()
+    {
+        bits &= ~REFERENCED;
+    }
+
+    void unmap()
+    {
+        bits = 0;
+    }
+};
+
+// Tabla de paginas de dos niveles: un directorio de 1024 punteros a hojas de 1024 PTEs que se
+// reservan al tocar por primera vez su rango. Un directorio cubre 2^20 paginas (4 GiB con paginas
+// de 4 KiB), asi un trace de 32 bits se traduce con dos indices. Las paginas de mas arriba, en
+// trazas de 64 bits, usan un directorio por region de 2^20 paginas
+struct RadixPageTable
+{
+    static const int LEAF_BITS = 10;
+    static const int DIRECTORY_BITS = 10;
+    static const size_t LEAF_SIZE = size_t(1) << LEAF_BITS;
+    static const size_t DIRECTORY_SIZE = size_t(1) << DIRECTORY_BITS;
+
+    struct Directory
+    {
+        vector<unique_ptr<PageTableEntry[]>> leaves;
+
+        Directory() : leaves(DIRECTORY_SIZE) {}
+    };
+
+    Directory low;                                    // Region 0: paginas < 2^20
+    unordered_map<uint64_t, unique_ptr<Directory>> high; // Regiones superiores
+    uint64_t cachedRegion = 0;                        // Ultima region superior consultada
+    Directory *cachedDirectory = nullptr;
+    size_t leafCount = 0;
+
+    RadixPageTable() = default;
+    RadixPageTable(const RadixPageTable &) = delete;
+    RadixPageTable &operator=(const RadixPageTable &) = delete;
+
+    Directory *directory(uint64_t page, bool create)
+    {
+        uint64_t region = page >> (LEAF_BITS + DIRECTORY_BITS);
+        if (region == 0) return &low;
+        if (cachedDirectory != nullptr && region == cachedRegion) return cachedDirectory;
 
-            nextFrame = (nextFrame + 1) % numFrames;
+        auto it = high.find(region);
+        if (it == high.end())
+        {
+            if (!create) return nullptr;
+            it = high.emplace(region, unique_ptr<Directory>(new Directory())).first;
         }
-        else
+        cachedRegion = region;
+        cachedDirectory = it->second.get();
+        return cachedDirectory;
+    }
+
+    // PTE de la pagina o nullptr si su hoja nunca se reservo; no reserva memoria
+    PageTableEntry *find(uint64_t page)
+    {
+        Directory *dir = directory(page, false);
+        if (dir == nullptr) return nullptr;
+        PageTableEntry *leaf = dir->leaves[(page >> LEAF_BITS) & (DIRECTORY_SIZE - 1)].get();
+        return leaf == nullptr ? nullptr : &leaf[page & (LEAF_SIZE - 1)];
+    }
+
+    // PTE de la pagina, reservando su hoja si hace falta
+    PageTableEntry &entry(uint64_t page)
+    {
+        unique_ptr<PageTableEntry[]> &leaf = directory(page, true)->leaves[(page >> LEAF_BITS) & (DIRECTORY_SIZE - 1)];
+        if (!leaf)
         {
-            // La página ya ha sido asignada a un marco
-            MemoryMapping &mapping = physicalMemoryMap[page];
-            mapping.dirty = mapping.dirty || (reference.operation == 'W');
+            leaf.reset(new PageTableEntry[LEAF_SIZE]());
+            leafCount++;
         }
+        return leaf[page & (LEAF_SIZE - 1)];
     }
-    //Reinicia nextFrame al final de cada simulacion
-    nextFrame = 0;
-}
 
-void loadMemoryTrace(vector<MemoryReference> &memoryTrace, int numAddresses)
+    // Bytes reservados por la tabla: directorios mas hojas
+    size_t memoryUsage() const
+    {
+        size_t directories = 1 + high.size();
+        return directories * DIRECTORY_SIZE * sizeof(unique_ptr<PageTableEntry[]>) + leafCount * LEAF_SIZE * sizeof(PageTableEntry);
+    }
+};
+
+// Tabla hash de direccionamiento abierto por numero de pagina (Robin Hood): las entradas van en
+// linea en un solo arreglo con capacidad potencia de dos, cada una con su distancia de sondeo. Al
+// insertar, la entrada mas lejos de su posicion ideal se queda con el lugar; al borrar, las
+// siguientes retroceden un lugar (sin tombstones). Reservada con reserve(n), no pide memoria
+// mientras tenga a lo sumo n paginas; si se pasa, duplica la capacidad
+template <typename Value>
+struct FlatPageMap
 {
-    ifstream file("gcc.trace");
-    string line;
-    int count = 0;
+    struct Slot
+    {
+        uint64_t page;
+        uint32_t probe; // Distancia a la posicion ideal mas uno; 0 = libre
+        Value value;
+    };
+
+    vector<Slot> slots;
+    size_t count = 0;
+    size_t mask = 0;
+    int shift = 64;
+
+    FlatPageMap() { rehash(16); }
+
+    size_t size() const { return count; }
+
+    // Capacidad para n paginas con factor de carga <= 3/4
+    void reserve(size_t n)
+    {
+        size_t capacity = 16;
+        while (capacity * 3 < n * 4) capacity *= 2;
+        if (capacity > slots.size()) rehash(capacity);
+    }
+
+    // Hash de Fibonacci: los bits altos del producto mezclan paginas consecutivas
+    size_t home(uint64_t page) const
+    {
+        return shift == 64 ? 0 : size_t((page * 0x9E3779B97F4A7C15ULL) >> shift);
+    }
 
-    if (file.is_open())
+    // Posicion de la pagina o SIZE_MAX si no esta
+    size_t findSlot(uint64_t page) const
     {
-        while (getline(file, line) && (numAddresses == -1 || count < numAddresses))
+        size_t slot = home(page);
+        for (uint32_t probe = 1;; probe++, slot = (slot + 1) & mask)
         {
-            istringstream iss(line);
-            MemoryReference reference;
-            if (iss >> reference.address >> reference.operation)
+            // Una entrada mas cerca de su inicio que nosotros indica que la pagina no esta
+            if (slots[slot].probe < probe) return SIZE_MAX;
+            if (slots[slot].page == page) return slot;
+        }
+    }
+
+    Value *find(uint64_t page)
+    {
+        size_t slot = findSlot(page);
+        return slot == SIZE_MAX ? nullptr : &slots[slot].value;
+    }
+
+    const Value *find(uint64_t page) const
+    {
+        size_t slot = findSlot(page);
+        return slot == SIZE_MAX ? nullptr : &slots[slot].value;
+    }
+
+    // Valor de la pagina; si no estaba se inserta con Value()
+    Value &operator[](uint64_t page)
+    {
+        Value *found = find(page);
+        if (found != nullptr) return *found;
+        if ((count + 1) * 4 > slots.size() * 3) rehash(slots.size() * 2);
+        count++;
+
+        Slot moving{page, 1, Value()};
+        Slot *inserted = nullptr;
+        for (size_t slot = home(page);; moving.probe++, slot = (slot + 1) & mask)
+        {
+            if (slots[slot].probe == 0)
+            {
+                slots[slot] = std::move(moving);
+                return inserted == nullptr ? slots[slot].value : inserted->value;
+            }
+            if (slots[slot].probe < moving.probe)
             {
-                memoryTrace.push_back(reference);
-                count++;
+                swap(slots[slot], moving);
+                if (inserted == nullptr) inserted = &slots[slot];
             }
         }
-        file.close();
     }
-}
 
-int simulatePageFaultsFIFO(const vector<MemoryReference> &memoryTrace, int numFrames, int &replacements)
-{
-    unordered_map<string, MemoryMapping> pageTable; //pageTable PhysicalMemoryMap
-    queue<string> frameQueue;
-    int pageFaults = 0;
-    int replace = 0;
+    bool erase(uint64_t page)
+    {
+        size_t slot = findSlot(page);
+        if (slot == SIZE_MAX) return false;
+        for (size_t next = (slot + 1) & mask; slots[next].probe > 1; slot = next, next = (next + 1) & mask)
+        {
+            slots[slot] = std::move(slots[next]);
+            slots[slot].probe--;
+        }
+        slots[slot].probe = 0;
+        count--;
+        return true;
+    }
 
-    for (const MemoryReference &reference : memoryTrace)
+    template <typename Visit>
+    void forEach(Visit visit) const
     {
-        string address = reference.address;
-        string page = address.substr(0, address.length() - 3); // Obtener la página (primeros dígitos de la dirección)
+        for (const Slot &slot : slots)
+        {
+            if (slot.probe != 0) visit(slot.page, slot.value);
+        }
+    }
 
-        if (pageTable.find(page) == pageTable.end())
+    void rehash(size_t capacity)
+    {
+        vector<Slot> old(capacity);
+        old.swap(slots);
+        mask = capacity - 1;
+        shift = 64;
+        for (size_t bits = capacity; bits > 1; bits >>= 1) shift--;
+        count = 0;
+        for (Slot &slot : old)
         {
-            // Page fault: la página no está en memoria
-            pageFaults++;
+            if (slot.probe != 0) (*this)[slot.page] = std::move(slot.value);
+        }
+    }
+};
+
+// Archivo de trace proyectado en memoria (mmap); en Windows se lee completo a un buffer
+struct MappedFile
+{
+    const char *data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    vector<char> buffer;
+#endif
 
-            if (frameQueue.size() >= numFrames)
+    explicit MappedFile(const string &path)
+    {
+#ifdef _WIN32
+        ifstream file(path, ios::binary);
+        if (!file.is_open()) return;
+        buffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+        data = buffer.data();
+        size = buffer.size();
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1) return;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0)
+        {
+            void *mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED)
             {
-                // Se debe reemplazar una página usando FIFO
-                string pageToRemove = frameQueue.front();
-                frameQueue.pop();
-                pageTable.erase(pageToRemove);
-                replace++;
+                madvise(mapped, info.st_size, MADV_SEQUENTIAL);
+                data = static_cast<const char *>(mapped);
+                size = info.st_size;
             }
-
-            // Agregar la nueva página a la tabla y a la cola de marcos
-            MemoryMapping mapping;
-            mapping.page = page;
-            mapping.frame = to_string(frameQueue.size());
-            mapping.dirty = (reference.operation == 'W');
-            pageTable[page] = mapping;
-            frameQueue.push(page);
         }
+        close(fd);
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifndef _WIN32
+        if (data != nullptr) munmap(const_cast<char *>(data), size);
+#endif
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+};
+
+// Valor de cada caracter hexadecimal, -1 si no lo es
+struct HexTable
+{
+    signed char value[256];
+
+    HexTable()
+    {
+        memset(value, -1, sizeof(value));
+        for (int c = '0'; c <= '9'; c++) value[c] = c - '0';
+        for (int c = 'a'; c <= 'f'; c++) value[c] = c - 'a' + 10;
+        for (int c = 'A'; c <= 'F'; c++) value[c] = c - 'A' + 10;
     }
+};
 
-    replacements = replace;
+static const HexTable hexTable;
 
-    return pageFaults;
+inline bool isTraceSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
 }
 
-int simulatePageFaultsLRU(const vector<MemoryReference> &memoryTrace, int numFrames, int &replacement)
+// Parsea una linea "xxxxxxxx R" en [line, lineEnd) directamente sobre el buffer.
+// Devuelve false si la linea no contiene direccion y operacion (como fallaba iss >>)
+inline bool parseTraceLine(const char *line, const char *lineEnd, MemoryReference &reference)
 {
-    unordered_map<string, MemoryMapping> pageTable;//Page Table PhyscalMemoryMap
-    list<string> frameList;
-    int pageFaults = 0;
-    int replace = 0;
+    const char *p = line;
+    while (p < lineEnd && isTraceSpace(*p)) p++;
+    if (lineEnd - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) p += 2;
 
-    for (const MemoryReference &reference : memoryTrace)
+    uint64_t address = 0;
+    const char *digits = p;
+    while (p < lineEnd && hexTable.value[(unsigned char)*p] >= 0)
     {
-        string address = reference.address;
-        string page = address.substr(0, address.length() - 3); // Obtener la página (primeros dígitos de la dirección)
+        address = (address << 4) | hexTable.value[(unsigned char)*p];
+        p++;
+    }
+    if (p == digits) return false;
 
-        if (pageTable.find(page) == pageTable.end())
-        {
-            // Page fault: la página no está en memoria
-            pageFaults++;
+    // Ignorar el resto del token de la direccion y los espacios hasta la operacion
+    while (p < lineEnd && !isTraceSpace(*p)) p++;
+    while (p < lineEnd && isTraceSpace(*p)) p++;
+    if (p == lineEnd) return false;
 
-            if (frameList.size() >= numFrames)
-            {
-                // Se debe reemplazar una página usando LRU
-                string pageToRemove = frameList.front();
-                frameList.pop_front();
-                pageTable.erase(pageToRemove);
-                replace++;
-            }
+    reference.address = address;
+    reference.page = address >> PAGE_OFFSET_BITS;
+    reference.operation = *p;
+    return true;
+}
 
-            // Agregar la nueva página a la tabla y al stack de marcos
-            MemoryMapping mapping;
-            mapping.page = page;
-            mapping.frame = to_string(frameList.size());
-            mapping.dirty = (reference.operation == 'W');
-            pageTable[page] = mapping;
-            frameList.push_back(page);
-        }
-        else
-        {
-            // La página ya está en memoria, actualizar su posición en la lista
-            frameList.remove(page);
-            frameList.push_back(page);
-        }
+// Convierte 8 digitos hex ASCII sin ramas, tratando los 8 bytes como un vector (SWAR). Devuelve
+// false si alguno no es un digito hex. Cada byte se valida con dos sumas por rango: sumar
+// 0x80 - lo prende el bit alto si c >= lo y sumar 0x7F - hi lo prende si c > hi; como todos los
+// bytes son < 0x80 ninguna suma acarrea al byte vecino
+inline bool parseHex8(const char *digits, uint64_t &value)
+{
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t high = 0x8080808080808080ULL;
+    uint64_t x;
+    memcpy(&x, digits, sizeof(x));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    x = __builtin_bswap64(x); // El primer caracter tiene que quedar en el byte bajo
+#endif
+
+    uint64_t lower = x | (ones * 0x20);
+    uint64_t digit = (x + ones * (0x80 - '0')) & ~(x + ones * (0x7F - '9'));
+    uint64_t letter = (lower + ones * (0x80 - 'a')) & ~(lower + ones * (0x7F - 'f'));
+    if (((digit | letter) & high) != high || (x & high) != 0) return false;
+
+    // Valor de cada nibble: las letras tienen el bit 6 prendido y valen (c & 0xF) + 9
+    uint64_t nibbles = (x & (ones * 0x0F)) + ((x >> 6) & ones) * 9;
+    // Juntar de a pares: el byte bajo de cada carril es el digito mas significativo
+    nibbles = ((nibbles & 0x000F000F000F000FULL) << 4) | ((nibbles >> 8) & 0x000F000F000F000FULL);
+    nibbles = ((nibbles & 0x000000FF000000FFULL) << 8) | ((nibbles >> 16) & 0x000000FF000000FFULL);
+    value = ((nibbles & 0xFFFF) << 16) | ((nibbles >> 32) & 0xFFFF);
+    return true;
+}
+
+// Parsea la linea que empieza en p y devuelve el comienzo de la siguiente (puede ser end + 1,
+// como al saltear el ultimo '\n'). Las lineas "xxxxxxxx R\n" de los traces se resuelven con
+// parseHex8 sin buscar el fin de linea; el resto pasa por memchr y parseTraceLine
+inline const char *parseNextTraceLine(const char *p, const char *end, MemoryReference &reference, bool &valid)
+{
+    uint64_t address;
+    if (end - p >= 11 && p[8] == ' ' && !isTraceSpace(p[9]) && p[9] != '\n' && parseHex8(p, address))
+    {
+        reference.address = address;
+        reference.page = address >> PAGE_OFFSET_BITS;
+        reference.operation = p[9];
+        valid = true;
+        if (p[10] == '\n') return p + 11;
+
+        // El resto de la linea se ignora, igual que en parseTraceLine
+        const char *lineEnd = static_cast<const char *>(memchr(p + 10, '\n', end - (p + 10)));
+        return lineEnd == nullptr ? end + 1 : lineEnd + 1;
     }
 
-    replacement = replace;
-    return pageFaults;
+    const char *lineEnd = static_cast<const char *>(memchr(p, '\n', end - p));
+    if (lineEnd == nullptr) lineEnd = end;
+    valid = parseTraceLine(p, lineEnd, reference);
+    return lineEnd + 1;
 }
 
-int simulatePageFaultsOPT(const vector<MemoryReference> &memoryTrace, int numFrames, int &replacements)
+#ifdef TRACE_BLOCK_SCAN
+// Bloque de 64 bytes del trace: el bit i de newlines (spaces) esta prendido si p[i] es '\n' (' ')
+struct TraceBlockMasks
 {
-    unordered_map<string, MemoryMapping> pageTable; // pageTable physicalMemoryMap
-    int pageFaults = 0;
-    int replace = 0;
+    uint64_t newlines;
+    uint64_t spaces;
+};
 
-    for (int i = 0; i < memoryTrace.size(); i++)
+// SSE2 esta en todo x86-64: cuatro comparaciones de 16 bytes por mascara
+inline TraceBlockMasks scanTraceBlockSSE2(const char *p)
+{
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i space = _mm_set1_epi8(' ');
+    TraceBlockMasks masks = {0, 0};
+    for (int k = 0; k < 4; k++)
     {
-        string address = memoryTrace[i].address;
-        string page = address.substr(0, address.length() - 3); // Obtener la página (primeros dígitos de la dirección)
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16 * k));
+        masks.newlines |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline)) << (16 * k);
+        masks.spaces |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, space)) << (16 * k);
+    }
+    return masks;
+}
 
-        if (pageTable.find(page) == pageTable.end())
-        {
-            // Page fault: la página no está en memoria
-            pageFaults++;
+// La misma busqueda con dos comparaciones de 32 bytes; solo se llama si la CPU tiene AVX2
+__attribute__((target("avx2"))) TraceBlockMasks scanTraceBlockAVX2(const char *p)
+{
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i space = _mm256_set1_epi8(' ');
+    __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 32));
+    TraceBlockMasks masks;
+    masks.newlines = (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, newline)) |
+                     (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, newline)) << 32;
+    masks.spaces = (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, space)) |
+                   (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, space)) << 32;
+    return masks;
+}
 
-            if (pageTable.size() >= numFrames)
-            {
-                // Se debe reemplazar una página usando OPT
-                string pageToRemove;
-                int maxDistance = -1;
+static const bool traceScanAVX2 = __builtin_cpu_supports("avx2");
 
-                // Recorrer las páginas en memoria y encontrar la página más lejana en el futuro
-                for (const auto &entry : pageTable)
-                {
-                    string currentPage = entry.first;
-                    int currentDistance = -1;
-
-                    for (int j = i + 1; j < memoryTrace.size(); j++)
-                    {
-                        if (memoryTrace[j].address.substr(0, memoryTrace[j].address.length() - 3) == currentPage)
-                        {
-                            currentDistance = j;
-                            break;
-                        }
-                    }
-
-                    if (currentDistance == -1)
-                    {
-                        // No se encontraron referencias futuras de la página, por lo que puede ser reemplazada inmediatamente
-                        pageToRemove = currentPage;
-                        break;
-                    }
-
-                    if (currentDistance > maxDistance)
-                    {
-                        maxDistance = currentDistance;
-                        pageToRemove = currentPage;
-                    }
-                }
+inline TraceBlockMasks scanTraceBlock(const char *p)
+{
+    return traceScanAVX2 ? scanTraceBlockAVX2(p) : scanTraceBlockSSE2(p);
+}
 
-                pageTable.erase(pageToRemove);
-                replace++;
+// Parsea de a bloques de 64 bytes las lineas canonicas "xxxxxxxx R\n": las mascaras del bloque dan
+// el comienzo de cada linea y si tiene ' ' en +8 y '\n' en +10 sin recorrerla, y la direccion sale
+// de parseHex8. Se detiene en la primera linea de otra forma (o si ya entrego maxLines) y devuelve
+// su comienzo para que la resuelva parseNextTraceLine. emit recibe cada referencia en orden
+template <typename Emit>
+const char *parseCanonicalTraceLines(const char *p, const char *end, size_t maxLines, Emit emit)
+{
+    while (end - p >= 64 && maxLines > 0)
+    {
+        TraceBlockMasks masks = scanTraceBlock(p);
+        uint64_t newlines = masks.newlines;
+        int start = 0;
+        while (newlines != 0)
+        {
+            int lineEnd = __builtin_ctzll(newlines);
+            newlines &= newlines - 1;
+            uint64_t address;
+            if (lineEnd - start != 10 || !((masks.spaces >> (start + 8)) & 1) || isTraceSpace(p[start + 9]) ||
+                !parseHex8(p + start, address))
+            {
+                return p + start;
             }
+            MemoryReference reference;
+            reference.address = address;
+            reference.page = address >> PAGE_OFFSET_BITS;
+            reference.operation = p[start + 9];
+            emit(reference);
+            start = lineEnd + 1;
+            if (--maxLines == 0) break;
+        }
+        if (start == 0) return p; // Una linea de mas de 64 bytes
+        p += start;
+    }
+    return p;
+}
+#endif
 
-            // Agregar la nueva página a la tabla
-            MemoryMapping mapping;
-            mapping.page = page;
-            mapping.frame = "";
-            mapping.dirty = (memoryTrace[i].operation == 'W');
-            pageTable[page] = mapping;
+// Parsea las lineas de [begin, end) agregandolas a memoryTrace hasta llegar a numAddresses (-1 = todas)
+void parseTraceBuffer(const char *begin, const char *end, vector<MemoryReference> &memoryTrace, int numAddresses)
+{
+    const char *p = begin;
+
+    while (p < end && (numAddresses == -1 || memoryTrace.size() < (size_t)numAddresses))
+    {
+#ifdef TRACE_BLOCK_SCAN
+        size_t maxLines = numAddresses == -1 ? SIZE_MAX : numAddresses - memoryTrace.size();
+        p = parseCanonicalTraceLines(p, end, maxLines, [&](const MemoryReference &reference) { memoryTrace.push_back(reference); });
+        if (p >= end || (numAddresses != -1 && memoryTrace.size() >= (size_t)numAddresses)) break;
+#endif
+        MemoryReference reference;
+        bool valid;
+        p = parseNextTraceLine(p, end, reference, valid);
+        if (valid)
+        {
+            memoryTrace.push_back(reference);
         }
     }
+}
+
+// Cuenta las lineas del buffer para reservar el trace de una sola vez
+size_t countTraceLines(const char *begin, const char *end)
+{
+    size_t lines = 0;
+    const char *p = begin;
+#ifdef TRACE_BLOCK_SCAN
+    for (; end - p >= 64; p += 64) lines += __builtin_popcountll(scanTraceBlock(p).newlines);
+    if (p == end) return lines + (p > begin && p[-1] != '\n'); // Ultima linea sin '\n'
+#endif
+    for (; p < end; p++)
+    {
+        p = static_cast<const char *>(memchr(p, '\n', end - p));
+        if (p == nullptr) return lines + 1;
+        lines++;
+    }
+    return lines;
+}
+
+// Formato binario de trace: encabezado fijo seguido de un varint por referencia con
+// (zigzag(pagina - pagina anterior) << 1) | (operacion == 'W'). Solo guarda el numero de pagina,
+// la direccion se reconstruye como pagina << pageOffsetBits
+const char BINARY_TRACE_MAGIC[8] = {'M', 'E', 'M', 'T', 'R', 'C', 'B', '1'};
+const uint32_t BINARY_TRACE_VERSION = 1;
+
+struct BinaryTraceHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t pageOffsetBits;
+    uint64_t count;
+};
+
+inline bool isBinaryTrace(const char *data, size_t size)
+{
+    return size >= sizeof(BinaryTraceHeader) && memcmp(data, BINARY_TRACE_MAGIC, sizeof(BINARY_TRACE_MAGIC)) == 0;
+}
+
+inline uint64_t zigzagEncode(int64_t value)
+{
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+inline int64_t zigzagDecode(uint64_t value)
+{
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+// Decodifica una referencia a partir de p; page lleva la pagina anterior y se actualiza.
+// Devuelve la posicion siguiente o nullptr si el varint esta truncado o pasa de 10 bytes
+inline const unsigned char *decodeBinaryReference(const unsigned char *p, const unsigned char *end, uint64_t &page,
+                                                  uint32_t pageOffsetBits, MemoryReference &reference)
+{
+    uint64_t value = 0;
+    int shift = 0;
+    while (p < end && (*p & 0x80))
+    {
+        if (shift > 56) return nullptr; // Un valor de 64 bits ocupa a lo sumo 10 bytes
+        value |= (uint64_t)(*p++ & 0x7f) << shift;
+        shift += 7;
+    }
+    if (p == end) return nullptr;
+    value |= (uint64_t)(*p++) << shift;
 
-    replacements = replace;
+    page += zigzagDecode(value >> 1);
+    reference.page = page;
+    reference.address = page << pageOffsetBits;
+    reference.operation = (value & 1) ? 'W' : 'R';
+    return p;
+}
 
-    return pageFaults;
+// Lee el encabezado sin confiar en el: la version debe ser conocida, las paginas de 4 KiB (el resto
+// del simulador cuenta paginas en esa unidad) y count se acota a los bytes disponibles, ya que cada
+// referencia ocupa al menos uno. Devuelve false con el error en cerr
+bool readBinaryTraceHeader(const char *data, size_t size, BinaryTraceHeader &header)
+{
+    memcpy(&header, data, sizeof(header));
+    if (header.version != BINARY_TRACE_VERSION)
+    {
+        cerr << "Version de trace binario no soportada: " << header.version << endl;
+        return false;
+    }
+    if (header.pageOffsetBits != PAGE_OFFSET_BITS)
+    {
+        cerr << "Trace binario con pageOffsetBits no soportado: " << header.pageOffsetBits << endl;
+        return false;
+    }
+    header.count = min<uint64_t>(header.count, size - sizeof(header));
+    return true;
 }
 
+// Decodifica hasta numAddresses referencias (-1 = todas) del trace binario ya proyectado.
+// Devuelve false si el encabezado es invalido
+bool parseBinaryTrace(const char *data, size_t size, vector<MemoryReference> &memoryTrace, int numAddresses)
+{
+    BinaryTraceHeader header;
+    if (!readBinaryTraceHeader(data, size, header)) return false;
+
+    uint64_t count = header.count;
+    if (numAddresses != -1) count = min(count, (uint64_t)numAddresses);
+    memoryTrace.reserve(memoryTrace.size() + count);
+
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(data) + sizeof(header);
+    const unsigned char *end = reinterpret_cast<const unsigned char *>(data) + size;
+    uint64_t page = 0;
+
+    for (uint64_t i = 0; i < count; i++)
+    {
+        MemoryReference reference;
+        p = decodeBinaryReference(p, end, page, header.pageOffsetBits, reference);
+        if (p == nullptr) break; // Varint truncado
+        memoryTrace.push_back(reference);
+    }
+    return true;
+}
 
-void printSummary(const unordered_map<string, MemoryMapping> &physicalMemoryMap, 
-const vector<MemoryReference> &memoryTrace,int pageFaults, int numFrames, int replace)
+// Escribe un trace referencia por referencia en texto ("xxxxxxxx R" por linea) o en el formato
+// binario, acumulando en un buffer de 1 MiB. close() vuelca el resto y completa el encabezado
+class TraceWriter
 {
-    int writesToDisk = 0;
-    double eat = 0.0;
+public:
+    TraceWriter(const string &filename, bool binaryFormat) : output(filename, ios::binary), binary(binaryFormat)
+    {
+        memcpy(header.magic, BINARY_TRACE_MAGIC, sizeof(header.magic));
+        header.version = BINARY_TRACE_VERSION;
+        header.pageOffsetBits = PAGE_OFFSET_BITS;
+        header.count = 0;
+        if (binary) output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        buffer.reserve(BUFFER_SIZE);
+    }
+
+    bool isOpen() const
+    {
+        return output.is_open();
+    }
 
-    for (const MemoryReference &reference : memoryTrace)
+    uint64_t count() const
     {
-        string address = reference.address;
-        string page = address.substr(0, address.length() - 3); // Obtener la página (primeros dígitos de la dirección)
+        return header.count;
+    }
 
-        if (physicalMemoryMap.find(page) != physicalMemoryMap.end())
+    void write(const MemoryReference &reference)
+    {
+        if (binary)
         {
-            // La página está en memoria física
-            MemoryMapping mapping = physicalMemoryMap.at(page);
-            if (reference.operation == 'W')
+            uint64_t value = (zigzagEncode((int64_t)(reference.page - previousPage)) << 1) | (reference.operation == 'W');
+            previousPage = reference.page;
+            while (value >= 0x80)
             {
-                mapping.dirty = true; // Actualizar dirty bit en caso de escritura
+                buffer.push_back((char)(value | 0x80));
+                value >>= 7;
             }
-            // physicalMemoryMap[page] = mapping;
+            buffer.push_back((char)value);
+        }
+        else
+        {
+            char line[32];
+            int length = snprintf(line, sizeof(line), "%08llx %c\n", (unsigned long long)reference.address, reference.operation);
+            buffer.insert(buffer.end(), line, line + length);
         }
+        header.count++;
 
-        if (reference.operation == 'W')
+        if (buffer.size() >= BUFFER_SIZE - 32)
         {
-            writesToDisk++; // Incrementar writesToDisk para cada operación de escritura
+            output.write(buffer.data(), buffer.size());
+            buffer.clear();
         }
     }
 
-    eat = pageFaults * 100.0; // Suponiendo un valor de 100 ns de acceso a memoria
-  
-    std::cout << "+------------------------------------------------+" << std::endl;
-    std::cout << "| Page Faults:                       |" << std::setw(10) << std::left << pageFaults << " |" << std::endl;
-    std::cout << "| Reemplazos realizados:             |" << std::setw(10) << std::left << replace << " |" << std::endl;
-    std::cout << "| Escrituras a disco:                |" << std::setw(10) << std::left << writesToDisk << " |" << std::endl;
-    std::cout << "| EAT (tiempo de acceso a memoria):  |" << std::setw(10) << std::left << eat << " |" << std::endl;
-    std::cout << "+------------------------------------------------+" << std::endl;
+    bool close()
+    {
+        output.write(buffer.data(), buffer.size());
+        buffer.clear();
+        if (binary)
+        {
+            // Reescribir el encabezado con la cantidad final de referencias
+            output.seekp(0);
+            output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        }
+        output.close();
+        return !output.fail();
+    }
+
+private:
+    static const size_t BUFFER_SIZE = 1 << 20;
+
+    ofstream output;
+    bool binary;
+    BinaryTraceHeader header;
+    vector<char> buffer;
+    uint64_t previousPage = 0;
+};
+
+// Convierte un trace de texto ("xxxxxxxx R" por linea) al formato binario
+bool convertTraceToBinary(const string &textFile, const string &binaryFile, uint64_t &count)
+{
+    MappedFile input(textFile);
+    if (input.data == nullptr) return false;
+    TraceWriter writer(binaryFile, true);
+    if (!writer.isOpen()) return false;
+
+    const char *p = input.data;
+    const char *end = input.data + input.size;
+
+    while (p < end)
+    {
+        MemoryReference reference;
+        bool valid;
+        p = parseNextTraceLine(p, end, reference, valid);
+        if (valid)
+        {
+            writer.write(reference);
+        }
+    }
+    count = writer.count();
+    return writer.close();
+}
+
+// Ejecuta task(0..numThreads-1), cada uno en su propio hilo (el 0 en el hilo actual)
+template <typename Task>
+void runInParallel(int numThreads, Task task)
+{
+    vector<thread> workers;
+    for (int t = 1; t < numThreads; t++) workers.emplace_back(task, t);
+    task(0);
+    for (thread &worker : workers) worker.join();
 }
 
+// Los archivos chicos se parsean en un solo hilo: no vale la pena crear hilos
+const size_t PARALLEL_PARSE_MIN_BYTES = 1 << 20;
 
-int main()
+// Parsea un trace de texto en paralelo. El buffer se divide en numThreads bloques alineados a
+// fin de linea; cada hilo cuenta sus lineas y luego parsea su bloque directamente en su tramo
+// del vector final, de modo que el orden del trace se conserva sin buffers intermedios
+void parseTraceBufferParallel(const char *begin, const char *end, vector<MemoryReference> &memoryTrace,
+                              int numAddresses, int numThreads)
 {
-    int frames[] = {10, 50, 100};
-    int numAddresses = -1; // Valor predeterminado para leer todo el archivo
+    // Con limite solo se parsean en paralelo las primeras numAddresses lineas
+    const char *limitEnd = end;
+    if (numAddresses != -1)
+    {
+        limitEnd = begin;
+        for (int n = 0; n < numAddresses && limitEnd < end; n++)
+        {
+            const char *lineEnd = static_cast<const char *>(memchr(limitEnd, '\n', end - limitEnd));
+            limitEnd = (lineEnd == nullptr) ? end : lineEnd + 1;
+        }
+    }
 
-    // Preguntar al usuario si desea leer todo el archivo o ingresar la cantidad de direcciones
-    char choice;
-    cout << "¿Desea leer todo el archivo gcc.trace? (y/n): ";
-    cin >> choice;
+    vector<const char *> bounds(numThreads + 1);
+    bounds[0] = begin;
+    bounds[numThreads] = limitEnd;
+    for (int t = 1; t < numThreads; t++)
+    {
+        const char *guess = max(bounds[t - 1], begin + (limitEnd - begin) * t / numThreads);
+        const char *lineEnd = static_cast<const char *>(memchr(guess, '\n', limitEnd - guess));
+        bounds[t] = (lineEnd == nullptr) ? limitEnd : lineEnd + 1;
+    }
+
+    vector<size_t> lines(numThreads);
+    runInParallel(numThreads, [&](int t) { lines[t] = countTraceLines(bounds[t], bounds[t + 1]); });
+
+    size_t base = memoryTrace.size();
+    vector<size_t> offsets(numThreads + 1, base);
+    for (int t = 0; t < numThreads; t++) offsets[t + 1] = offsets[t] + lines[t];
+    memoryTrace.resize(offsets[numThreads]);
+
+    vector<size_t> parsed(numThreads, 0);
+    runInParallel(numThreads, [&](int t)
+    {
+        MemoryReference *out = memoryTrace.data() + offsets[t];
+        const char *p = bounds[t];
+        while (p < bounds[t + 1])
+        {
+#ifdef TRACE_BLOCK_SCAN
+            p = parseCanonicalTraceLines(p, bounds[t + 1], SIZE_MAX, [&](const MemoryReference &reference) { out[parsed[t]++] = reference; });
+            if (p >= bounds[t + 1]) break;
+#endif
+            bool valid;
+            p = parseNextTraceLine(p, bounds[t + 1], out[parsed[t]], valid);
+            if (valid) parsed[t]++;
+        }
+    });
 
-    if (choice == 'n' || choice == 'N')
+    // Las lineas invalidas dejan huecos al final de cada tramo: se compactan en orden
+    size_t filled = offsets[0] + parsed[0];
+    for (int t = 1; t < numThreads; t++)
     {
-        cout << "Ingrese la cantidad de direcciones a leer: ";
-        cin >> numAddresses;
+        if (filled != offsets[t])
+        {
+            memmove(memoryTrace.data() + filled, memoryTrace.data() + offsets[t], parsed[t] * sizeof(MemoryReference));
+        }
+        filled += parsed[t];
     }
+    memoryTrace.resize(filled);
 
-    // Generar el trace de memoria aleatorio
-    vector<MemoryReference> memoryTrace;
-    loadMemoryTrace(memoryTrace, numAddresses);
+    // Si hubo lineas invalidas dentro del limite, se completa con el resto del archivo
+    if (limitEnd < end)
+    {
+        parseTraceBuffer(limitEnd, end, memoryTrace, numAddresses);
+    }
+}
 
-cout <<"\n";
-cout << "            Tabla Resumen           \n\n"<<endl;
-    // Realizar simulación para cada cantidad de frames
-    for (int i = 0; i < sizeof(frames) / sizeof(frames[0]); i++)
+// numThreads = 0 usa todos los nucleos disponibles para los traces de texto grandes.
+// Devuelve false si el archivo no existe, esta vacio o su encabezado binario es invalido
+bool loadMemoryTrace(const string &memoryFile, vector<MemoryReference> &memoryTrace, int numAddresses, int numThreads = 0)
+{
+    MappedFile file(memoryFile);
+    if (file.data == nullptr) return false;
+    if (numThreads <= 0) numThreads = max(1u, thread::hardware_concurrency());
+
+    if (isBinaryTrace(file.data, file.size))
+    {
+        // Los deltas del formato binario se decodifican en secuencia
+        if (!parseBinaryTrace(file.data, file.size, memoryTrace, numAddresses)) return false;
+    }
+    else if (numThreads > 1 && file.size >= PARALLEL_PARSE_MIN_BYTES)
     {
-        int numFrames = frames[i];
+        parseTraceBufferParallel(file.data, file.data + file.size, memoryTrace, numAddresses, numThreads);
+    }
+    else
+    {
+        size_t lines = countTraceLines(file.data, file.data + file.size);
+        if (numAddresses != -1) lines = min(lines, (size_t)numAddresses);
+        memoryTrace.reserve(memoryTrace.size() + lines);
+
+        parseTraceBuffer(file.data, file.data + file.size, memoryTrace, numAddresses);
+    }
+    return true;
+}
 
+bool loadMemoryTrace(vector<MemoryReference> &memoryTrace, int numAddresses, int numThreads = 0)
+{
+    return loadMemoryTrace("gcc.trace", memoryTrace, numAddresses, numThreads);
+}
 
-        // Simulación FIFO
-        std::cout << "\033[1;31mSimulación FIFO para \033[0m" << numFrames << "\033[1;31m frames:\033[0m " << std::endl;
-        unordered_map<string, MemoryMapping> physicalMemoryMapFIFO;
-        generatePhysicalMemoryMap(memoryTrace, physicalMemoryMapFIFO, numFrames);
-        int pageFaultsFIFO = 0;
-        int replacementsFIFO = 0;
-        pageFaultsFIFO = simulatePageFaultsFIFO(memoryTrace, numFrames, replacementsFIFO);
-        printSummary(physicalMemoryMapFIFO, memoryTrace, pageFaultsFIFO, numFrames, replacementsFIFO);
-        cout << endl;
+// Lee un entero positivo en decimal, sin signo ni texto detras; false si no es valido o no cabe en int
+bool parsePositiveInt(const string &text, int &value)
+{
+    if (text.empty() || !isdigit((unsigned char)text[0])) return false;
+    char *end = nullptr;
+    errno = 0;
+    long parsed = strtol(text.c_str(), &end, 10);
+    if (errno == ERANGE || *end != '\0' || parsed < 1 || parsed > INT_MAX) return false;
+    value = parsed;
+    return true;
+}
 
-        // Simulación LRU
-         std::cout << "\033[1;35mSimulación LRU para \033[0m" << numFrames << "\033[1;35m frames:\033[0m " << std::endl;
-        unordered_map<string, MemoryMapping> physicalMemoryMapLRU;
-        generatePhysicalMemoryMap(memoryTrace, physicalMemoryMapLRU, numFrames);
-        int pageFaultsLRU = 0;
-        int replacementsLRU = 0;
-        pageFaultsLRU = simulatePageFaultsLRU(memoryTrace, numFrames, replacementsLRU);
-        printSummary(physicalMemoryMapLRU, memoryTrace, pageFaultsLRU, numFrames, replacementsLRU);
-        cout << endl;
+// Lee un tamaño de pagina como 4K, 16K, 64K, 2M o en bytes y devuelve sus bits de desplazamiento.
+// Debe ser potencia de dos y no menor que la pagina base; -1 si no es valido
+int parsePageSize(const string &text)
+{
+    if (text.empty() || !isdigit((unsigned char)text[0])) return -1;
+    char *suffix = nullptr;
+    errno = 0;
+    uint64_t size = strtoull(text.c_str(), &suffix, 10);
+    if (errno == ERANGE) return -1;
+
+    int unitBits = 0;
+    if (*suffix == 'K' || *suffix == 'k') unitBits = 10;
+    else if (*suffix == 'M' || *suffix == 'm') unitBits = 20;
+    else if (*suffix == 'G' || *suffix == 'g') unitBits = 30;
+    else if (*suffix != '\0') return -1;
+    if (unitBits != 0 && suffix[1] != '\0') return -1; // Solo la unidad, sin texto detras
+    if (size > (UINT64_MAX >> unitBits)) return -1;
+    size <<= unitBits;
+
+    if (size == 0 || (size & (size - 1)) != 0) return -1;
+    int bits = 0;
+    while ((uint64_t(1) << bits) < size) bits++;
+    return bits >= PAGE_OFFSET_BITS ? bits : -1;
+}
+
+// Recalcula los numeros de pagina para otro tamaño de pagina a partir de la direccion ya
+// parseada; con la pagina base no hace nada. En traces binarios la direccion es pagina base << 12
+void applyPageSize(MemoryReference *begin, MemoryReference *end, int pageSizeBits)
+{
+    if (pageSizeBits == PAGE_OFFSET_BITS) return;
+    for (MemoryReference *reference = begin; reference != end; reference++)
+    {
+        reference->page = reference->address >> pageSizeBits;
+    }
+}
 
-        // Simulación OPT
-       std::cout << " \033[1;33mSimulación OPT para \033[0m" << numFrames << "\033[1;33m frames:\033[0m " << std::endl;
-        unordered_map<string, MemoryMapping> physicalMemoryMapOPT;
-        generatePhysicalMemoryMap(memoryTrace, physicalMemoryMapOPT, numFrames);
-        int pageFaultsOPT = 0;
-        int replacementsOPT = 0;
-        pageFaultsOPT = simulatePageFaultsOPT(memoryTrace, numFrames, replacementsOPT);
-        printSummary(physicalMemoryMapOPT, memoryTrace, pageFaultsOPT, numFrames, replacementsOPT);
-        cout << endl; }
-    return 0;}
+// Cargas sinteticas reproducibles para pruebas de escala sin depender de los traces en disco
+enum class WorkloadKind
+{
+    Zipf,    // Popularidad de paginas segun Zipf: la pagina 0 es la mas usada
+    Uniform, // Cualquier pagina del footprint con la misma probabilidad
+    Scan,    // Recorrido secuencial de 64 en 64 bytes sobre todo el footprint, repetido
+    Loop,    // Una referencia por pagina recorriendo el footprint en ciclo
+    Phase    // Zipf cuyo conjunto caliente se corre medio footprint en cada fase
+};
+
+struct WorkloadConfig
+{
+    WorkloadKind kind = WorkloadKind::Zipf;
+    uint64_t footprint = 1 << 16; // Paginas distintas (por fase en Phase)
+    uint64_t length = 1000000;    // Referencias
+    double writeRatio = 0.3;
+    uint64_t seed = 1;
+    double zipfTheta = 0.99;      // Sesgo de Zipf, distinto de 1
+    uint64_t phaseLength = 0;     // Referencias por fase; 0 = length / 10
+};
+
+// Devuelve false si el nombre no es una carga conocida
+bool parseWorkloadKind(const string &name, WorkloadKind &kind)
+{
+    if (name == "zipf") kind = WorkloadKind::Zipf;
+    else if (name == "uniform") kind = WorkloadKind::Uniform;
+    else if (name == "scan") kind = WorkloadKind::Scan;
+    else if (name == "loop") kind = WorkloadKind::Loop;
+    else if (name == "phase") kind = WorkloadKind::Phase;
+    else return false;
+    return true;
+}
+
+// Genera la carga por bloques, asi puede alimentar a los simuladores en streaming sin
+// materializar miles de millones de referencias
+class TraceGenerator
+{
+public:
+    explicit TraceGenerator(const WorkloadConfig &workload) : config(workload)
+    {
+        config.footprint = max<uint64_t>(config.footprint, 1);
+        if (config.phaseLength == 0) config.phaseLength = max<uint64_t>(config.length / 10, 1);
+        if (config.kind == WorkloadKind::Zipf || config.kind == WorkloadKind::Phase) prepareZipf();
+        reset();
+    }
+
+    void reset()
+    {
+        state = config.seed;
+        produced = 0;
+    }
+
+    // Llena chunk con hasta chunkSize referencias; false cuando ya se generaron length
+    bool next(vector<MemoryReference> &chunk, size_t chunkSize)
+    {
+        chunk.clear();
+        while (chunk.size() < chunkSize && produced < config.length)
+        {
+            chunk.push_back(generate());
+        }
+        return !chunk.empty();
+    }
+
+private:
+    WorkloadConfig config;
+    uint64_t state;
+    uint64_t produced;
+    double zetaN = 0;
+    double alpha = 0;
+    double eta = 0;
+
+    // splitmix64
+    uint64_t random()
+    {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    double uniform()
+    {
+        return (random() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Suma exacta hasta 2^24 terminos; mas alla se aproxima con la integral de x^-theta
+    static double zeta(uint64_t n, double theta)
+    {
+        const uint64_t exactTerms = 1 << 24;
+        double sum = 0;
+        for (uint64_t i = 1; i <= min(n, exactTerms); i++) sum += 1.0 / pow((double)i, theta);
+        if (n > exactTerms) sum += (pow((double)n, 1 - theta) - pow((double)exactTerms, 1 - theta)) / (1 - theta);
+        return sum;
+    }
+
+    // Constantes del metodo de Gray et al. para muestrear Zipf en O(1)
+    void prepareZipf()
+    {
+        double theta = config.zipfTheta;
+        zetaN = zeta(config.footprint, theta);
+        alpha = 1.0 / (1.0 - theta);
+        eta = (1 - pow(2.0 / config.footprint, 1 - theta)) / (1 - zeta(2, theta) / zetaN);
+    }
+
+    uint64_t zipfRank()
+    {
+        double u = uniform();
+        double uz = u * zetaN;
+        if (uz < 1.0) return 0;
+        if (uz < 1.0 + pow(0.5, config.zipfTheta)) return 1;
+        return min(config.footprint - 1, (uint64_t)(config.footprint * pow(eta * u - eta + 1, alpha)));
+    }
+
+    MemoryReference generate()
+    {
+        uint64_t i = produced++;
+        uint64_t bits = random();
+        uint64_t address;
+        switch (config.kind)
+        {
+        case WorkloadKind::Uniform:
+            address = ((bits % config.footprint) << PAGE_OFFSET_BITS) | ((bits >> 48) & 0xff8);
+            break;
+        case WorkloadKind::Scan:
+            address = (i * 64) % (config.footprint << PAGE_OFFSET_BITS);
+            break;
+        case WorkloadKind::Loop:
+            address = ((i % config.footprint) << PAGE_OFFSET_BITS) | ((bits >> 48) & 0xff8);
+            break;
+        case WorkloadKind::Phase:
+            address = ((zipfRank() + (i / config.phaseLength) * (config.footprint / 2)) << PAGE_OFFSET_BITS) | ((bits >> 48) & 0xff8);
+            break;
+        default:
+            address = (zipfRank() << PAGE_OFFSET_BITS) | ((bits >> 48) & 0xff8);
+            break;
+        }
+
+        MemoryReference reference;
+        reference.address = address;
+        reference.page = address >> PAGE_OFFSET_BITS;
+        reference.operation = uniform() < config.writeRatio ? 'W' : 'R';
+        return reference;
+    }
+};
+
+// Materializa la carga completa en memoria
+vector<MemoryReference> generateMemoryTrace(const WorkloadConfig &workload)
+{
+    vector<MemoryReference> memoryTrace;
+    memoryTrace.reserve(workload.length);
+    TraceGenerator generator(workload);
+    vector<MemoryReference> chunk;
+    while (generator.next(chunk, 1 << 16)) memoryTrace.insert(memoryTrace.end(), chunk.begin(), chunk.end());
+    return memoryTrace;
+}
+
+// Guarda la carga en texto o binario generandola por bloques
+bool saveGeneratedTrace(const WorkloadConfig &workload, const string &filename, bool binary)
+{
+    TraceWriter writer(filename, binary);
+    if (!writer.isOpen()) return false;
+    TraceGenerator generator(workload);
+    vector<MemoryReference> chunk;
+    while (generator.next(chunk, 1 << 16))
+    {
+        for (const MemoryReference &reference : chunk) writer.write(reference);
+    }
+    return writer.close();
+}
+
+// Lector en streaming: entrega el trace (texto o binario) en bloques de tamaño fijo para
+// simular sin materializar el vector<MemoryReference> completo
+class TraceReader
+{
+public:
+    static const size_t CHUNK_SIZE = 1 << 16;
+
+    TraceReader(const string &memoryFile, int numAddresses, int pageSize = PAGE_OFFSET_BITS)
+        : file(memoryFile), limit(numAddresses), pageSizeBits(pageSize)
+    {
+        binary = file.data != nullptr && isBinaryTrace(file.data, file.size);
+        validHeader = !binary || readBinaryTraceHeader(file.data, file.size, header);
+        rewind();
+    }
+
+    // Entrega una carga sintetica en vez de leer un archivo
+    TraceReader(const WorkloadConfig &workload, int pageSize = PAGE_OFFSET_BITS)
+        : file(""), limit(-1), pageSizeBits(pageSize), binary(false), generator(new TraceGenerator(workload))
+    {
+        rewind();
+    }
+
+    bool isOpen() const
+    {
+        return (file.data != nullptr && validHeader) || generator;
+    }
+
+    // Referencias entregadas desde el ultimo rewind
+    uint64_t references() const
+    {
+        return delivered;
+    }
+
+    // Vuelve al inicio del trace para la siguiente simulación
+    void rewind()
+    {
+        if (generator) generator->reset();
+        pos = file.data;
+        delivered = 0;
+        previousPage = 0;
+        pageOffsetBits = PAGE_OFFSET_BITS;
+        remaining = UINT64_MAX;
+        if (binary)
+        {
+            pos += sizeof(header);
+            pageOffsetBits = header.pageOffsetBits;
+            remaining = validHeader ? header.count : 0;
+        }
+    }
+
+    // Llena chunk con hasta CHUNK_SIZE referencias; devuelve false al terminar el trace
+    bool next(vector<MemoryReference> &chunk)
+    {
+        chunk.clear();
+        if (generator)
+        {
+            generator->next(chunk, CHUNK_SIZE);
+            delivered += chunk.size();
+            applyPageSize(chunk.data(), chunk.data() + chunk.size(), pageSizeBits);
+            return !chunk.empty();
+        }
+        if (pos == nullptr) return false;
+        const char *end = file.data + file.size;
+
+        while (chunk.size() < CHUNK_SIZE && pos < end && remaining > 0 && (limit == -1 || delivered < (size_t)limit))
+        {
+            MemoryReference reference;
+            if (binary)
+            {
+                const unsigned char *p = reinterpret_cast<const unsigned char *>(pos);
+                p = decodeBinaryReference(p, reinterpret_cast<const unsigned char *>(end), previousPage, pageOffsetBits, reference);
+                if (p == nullptr)
+                {
+                    pos = end;
+                    break;
+                }
+                pos = reinterpret_cast<const char *>(p);
+                remaining--;
+            }
+            else
+            {
+                bool valid;
+                pos = parseNextTraceLine(pos, end, reference, valid);
+                if (!valid) continue;
+            }
+            chunk.push_back(reference);
+            delivered++;
+        }
+
+        applyPageSize(chunk.data(), chunk.data() + chunk.size(), pageSizeBits);
+        return !chunk.empty();
+    }
+
+private:
+    MappedFile file;
+    int limit;
+    int pageSizeBits; // Tamaño de pagina de la simulacion
+    bool binary;
+    bool validHeader = true;
+    BinaryTraceHeader header; // Ya validado, solo si binary
+    const char *pos;
+    size_t delivered;
+    uint64_t previousPage;
+    uint32_t pageOffsetBits;
+    uint64_t remaining;
+    unique_ptr<TraceGenerator> generator;
+};
+
+// Pasa todo el trace del lector por un simulador incremental, bloque por bloque
+template <typename Simulator>
+void streamMemoryTrace(TraceReader &reader, Simulator &simulator)
+{
+    vector<MemoryReference> chunk;
+    chunk.reserve(TraceReader::CHUNK_SIZE);
+    reader.rewind();
+    while (reader.next(chunk))
+    {
+        simulator.simulate(chunk.data(), chunk.data() + chunk.size());
+    }
+}
+
+// Reemplazo dentro de cada conjunto de la TLB
+enum class TLBReplacement
+{
+    LRU,
+    FIFO,
+    Random
+};
+
+// Geometria de un nivel de TLB; entries = 0 deshabilita el nivel
+struct TLBConfig
+{
+    int entries = 0;
+    int ways = 4; // Asociatividad; ways >= entries la vuelve totalmente asociativa
+    TLBReplacement replacement = TLBReplacement::LRU;
+};
+
+// TLB de uno o dos niveles (L1 y L2 opcional) por delante de la tabla de paginas
+struct TLBHierarchyConfig
+{
+    TLBConfig l1;
+    TLBConfig l2;
+
+    bool enabled() const
+    {
+        return l1.entries > 0;
+    }
+};
+
+// Lee "ENTRADAS[:VIAS[:LRU|FIFO|RANDOM]]", por ejemplo 64:4:LRU. Las entradas deben repartirse en
+// conjuntos completos (multiplo de las vias, o vias >= entradas); false si algo no es valido
+bool parseTLBConfig(const string &text, TLBConfig &config)
+{
+    config = TLBConfig();
+    istringstream fields(text);
+    string field;
+    if (!getline(fields, field, ':') || !parsePositiveInt(field, config.entries)) return false;
+    if (getline(fields, field, ':') && !parsePositiveInt(field, config.ways)) return false;
+    if (getline(fields, field, ':'))
+    {
+        if (field == "LRU") config.replacement = TLBReplacement::LRU;
+        else if (field == "FIFO") config.replacement = TLBReplacement::FIFO;
+        else if (field == "RANDOM") config.replacement = TLBReplacement::Random;
+        else return false;
+    }
+    if (getline(fields, field)) return false; // Campos de mas
+    return config.ways >= config.entries || config.entries % config.ways == 0;
+}
+
+// Un nivel de TLB asociativo por conjuntos. Cada via guarda pagina y marco, asi un hit traduce
+// sin consultar la tabla de paginas. Los arreglos son planos: conjunto s ocupa [s*ways, (s+1)*ways)
+struct TLB
+{
+    int numSets = 0;
+    int ways = 0;
+    TLBReplacement replacement = TLBReplacement::LRU;
+    vector<uint64_t> tags;   // Pagina + 1; 0 marca una via vacia
+    vector<int> frames;
+    vector<uint64_t> stamps; // Ultimo uso (LRU) o llegada (FIFO)
+    uint64_t tick = 0;
+    uint64_t randomState = 0x9E3779B97F4A7C15ULL;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    explicit TLB(const TLBConfig &config)
+    {
+        if (config.entries <= 0) return;
+        ways = min(config.ways, config.entries);
+        assert(config.entries % ways == 0); // parseTLBConfig no acepta conjuntos incompletos
+        numSets = config.entries / ways;
+        replacement = config.replacement;
+        tags.assign((size_t)numSets * ways, 0);
+        frames.assign((size_t)numSets * ways, -1);
+        stamps.assign((size_t)numSets * ways, 0);
+    }
+
+    bool enabled() const
+    {
+        return numSets > 0;
+    }
+
+    size_t setBase(uint64_t page) const
+    {
+        return (size_t)(page % numSets) * ways;
+    }
+
+    // Marco de la pagina o -1 si no esta en la TLB
+    int lookup(uint64_t page)
+    {
+        size_t base = setBase(page);
+        for (int way = 0; way < ways; way++)
+        {
+            if (tags[base + way] == page + 1)
+            {
+                hits++;
+                if (replacement == TLBReplacement::LRU) stamps[base + way] = ++tick;
+                return frames[base + way];
+            }
+        }
+        misses++;
+        return -1;
+    }
+
+    // Agrega una pagina que no esta en la TLB, desalojando una via del conjunto si esta lleno
+    void fill(uint64_t page, int frame)
+    {
+        size_t base = setBase(page);
+        size_t victim = base;
+        bool full = true;
+        for (int way = 0; way < ways; way++)
+        {
+            if (tags[base + way] == 0)
+            {
+                victim = base + way;
+                full = false;
+                break;
+            }
+            if (stamps[base + way] < stamps[victim]) victim = base + way;
+        }
+        if (full && replacement == TLBReplacement::Random)
+        {
+            // xorshift64: barato y reproducible entre corridas
+            randomState ^= randomState << 13;
+            randomState ^= randomState >> 7;
+            randomState ^= randomState << 17;
+            victim = base + randomState % ways;
+        }
+        tags[victim] = page + 1;
+        frames[victim] = frame;
+        stamps[victim] = ++tick;
+    }
+
+    // La pagina salio de memoria: su traduccion deja de ser valida
+    void invalidate(uint64_t page)
+    {
+        size_t base = setBase(page);
+        for (int way = 0; way < ways; way++)
+        {
+            if (tags[base + way] == page + 1) tags[base + way] = 0;
+        }
+    }
+};
+
+// L1 y L2 opcional; un hit en L2 se copia a L1 y un recorrido de la tabla llena ambos niveles
+struct TLBHierarchy
+{
+    TLB l1;
+    TLB l2;
+    uint64_t walks = 0; // Traducciones que tuvieron que recorrer la tabla de paginas
+
+    explicit TLBHierarchy(const TLBHierarchyConfig &config) : l1(config.l1), l2(config.l2) {}
+
+    int translate(uint64_t page)
+    {
+        int frame = l1.lookup(page);
+        if (frame >= 0) return frame;
+        if (l2.enabled())
+        {
+            frame = l2.lookup(page);
+            if (frame >= 0)
+            {
+                l1.fill(page, frame);
+                return frame;
+            }
+        }
+        walks++;
+        return -1;
+    }
+
+    void fill(uint64_t page, int frame)
+    {
+        l1.fill(page, frame);
+        if (l2.enabled()) l2.fill(page, frame);
+    }
+
+    void invalidate(uint64_t page)
+    {
+        l1.invalidate(page);
+        if (l2.enabled()) l2.invalidate(page);
+    }
+};
+
+// Readahead al fallar: fixed trae las window paginas siguientes; stride repite el salto entre
+// los dos ultimos fallos si se mantuvo; adaptive imita el readahead de Linux, la ventana empieza
+// en window y se duplica hasta maxWindow mientras el acceso siga siendo secuencial
+enum class PrefetchMode
+{
+    None,
+    Fixed,
+    Stride,
+    Adaptive
+};
+
+struct PrefetchConfig
+{
+    PrefetchMode mode = PrefetchMode::None;
+    int window = 4;     // Paginas por fallo (ventana inicial en adaptive)
+    int maxWindow = 32; // Tope de la ventana adaptativa
+
+    bool enabled() const
+    {
+        return mode != PrefetchMode::None;
+    }
+};
+
+// Lee "fixed|stride|adaptive[:VENTANA[:MAXIMO]]", por ejemplo adaptive:4:32. Si no se da el maximo
+// queda al menos en la ventana; false si algo no es valido o el maximo es menor que la ventana
+bool parsePrefetchConfig(const string &text, PrefetchConfig &config)
+{
+    config = PrefetchConfig();
+    istringstream fields(text);
+    string field;
+    getline(fields, field, ':');
+    if (field == "fixed") config.mode = PrefetchMode::Fixed;
+    else if (field == "stride") config.mode = PrefetchMode::Stride;
+    else if (field == "adaptive") config.mode = PrefetchMode::Adaptive;
+    else return false;
+    if (getline(fields, field, ':') && !parsePositiveInt(field, config.window)) return false;
+    if (getline(fields, field, ':'))
+    {
+        if (!parsePositiveInt(field, config.maxWindow) || config.maxWindow < config.window) return false;
+    }
+    if (getline(fields, field)) return false; // Campos de mas
+    config.maxWindow = max(config.maxWindow, config.window);
+    return true;
+}
+
+// Decide que paginas traer y cuenta cuantas sirvieron. Las paginas sugeridas quedan en candidates
+struct Prefetcher
+{
+    PrefetchConfig config;
+    bool hasFault = false;
+    uint64_t lastFault = 0;
+    int64_t lastStride = 0;
+    int window;
+    uint64_t nextStart = 0;       // Adaptive: primera pagina despues de la ultima ventana
+    uint64_t marker = UINT64_MAX; // Adaptive: su primer uso trae la siguiente ventana por adelantado
+    uint64_t issued = 0;          // Paginas traidas por adelantado
+    uint64_t useful = 0;          // Usadas antes de salir de memoria
+    uint64_t wasted = 0;          // Desalojadas sin usarse
+    vector<uint64_t> candidates;
+
+    explicit Prefetcher(const PrefetchConfig &prefetchConfig) : config(prefetchConfig), window(prefetchConfig.window) {}
+
+    void addWindow(uint64_t start, int size)
+    {
+        for (int k = 0; k < size; k++) candidates.push_back(start + k);
+    }
+
+    const vector<uint64_t> &onFault(uint64_t page)
+    {
+        candidates.clear();
+        if (config.mode == PrefetchMode::Fixed)
+        {
+            addWindow(page + 1, config.window);
+        }
+        else if (config.mode == PrefetchMode::Stride)
+        {
+            int64_t stride = (int64_t)(page - lastFault);
+            if (hasFault && stride != 0 && stride == lastStride)
+            {
+                for (int64_t k = 1; k <= config.window; k++)
+                {
+                    int64_t next = (int64_t)page + k * stride;
+                    if (next < 0) break;
+                    candidates.push_back(next);
+                }
+            }
+            lastStride = stride;
+        }
+        else if (config.mode == PrefetchMode::Adaptive)
+        {
+            // Un fallo que sigue a la ventana anterior es acceso secuencial: la ventana crece;
+            // un salto a otra zona vuelve a la ventana inicial
+            bool sequential = hasFault && (page == lastFault + 1 || page == nextStart);
+            window = sequential ? min(2 * window, config.maxWindow) : config.window;
+            addWindow(page + 1, window);
+            marker = page + 1 + window / 2;
+            nextStart = page + 1 + window;
+        }
+        lastFault = page;
+        hasFault = true;
+        return candidates;
+    }
+
+    // Primer uso de una pagina traida por adelantado
+    const vector<uint64_t> &onPrefetchHit(uint64_t page)
+    {
+        candidates.clear();
+        useful++;
+        if (config.mode == PrefetchMode::Adaptive && page == marker)
+        {
+            // Readahead asincrono: al llegar al marcador se pide la ventana siguiente, mas grande
+            window = min(2 * window, config.maxWindow);
+            addWindow(nextStart, window);
+            marker = nextStart + window / 2;
+            nextStart += window;
+        }
+        return candidates;
+    }
+};
+
+// Motor comun de simulacion: la tabla de paginas, los marcos y los contadores son iguales para
+// todos los algoritmos y la politica solo decide a quien desalojar. La politica es un parametro
+// de template, asi sus hooks se expanden en linea sin comparar strings ni usar funciones virtuales.
+// Una politica se construye con la cantidad de marcos e implementa:
+//   void onHit(int frame, const MemoryReference &reference)   la pagina del marco se volvio a usar
+//   void onMiss(int frame, const MemoryReference &reference)  la pagina acaba de cargarse en el marco
+//   int chooseVictim(const MemoryReference &reference)        marco a desalojar con la memoria llena
+// Las politicas que leen los bits de la PTE (la familia Clock) reciben los marcos del simulador;
+// para las demas no hace nada
+template <typename Policy>
+void attachFrames(Policy &, const vector<MemoryMapping> &) {}
+
+// Si tiene TLB, cada referencia se traduce primero en ella y solo sus fallos consultan pageTable.
+// Si tiene prefetcher, las paginas que sugiere se cargan como fallos normales de la politica pero
+// sin contar como page faults; por rafaga se traen a lo sumo numFrames - 1
+template <typename Policy>
+struct PageReplacementSimulator
+{
+    Policy policy;
+    RadixPageTable pageTable;         // Pagina -> marco
+    TLBHierarchy *tlb = nullptr;      // Opcional
+    Prefetcher *prefetcher = nullptr; // Opcional
+    vector<MemoryMapping> frames;
+    int numFrames;
+    uint64_t pageFaults = 0;
+    uint64_t replace = 0;
+    uint64_t writes = 0;
+    uint64_t dirtyEvictions = 0;
+    uint64_t pageTableLookups = 0; // Consultas a pageTable (fallos de TLB y chequeos del readahead)
+
+    template <typename... Args>
+    explicit PageReplacementSimulator(int frameCount, Args &&...args)
+        : policy(frameCount, std::forward<Args>(args)...), numFrames(frameCount)
+    {
+        frames.reserve(frameCount);
+        attachFrames(policy, frames);
+    }
+
+    void simulate(const MemoryReference *begin, const MemoryReference *end)
+    {
+        for (const MemoryReference *reference = begin; reference != end; reference++)
+        {
+            bool write = (reference->operation == 'W');
+            writes += write;
+            int frame = (tlb != nullptr) ? tlb->translate(reference->page) : -1;
+            if (frame < 0)
+            {
+                pageTableLookups++;
+                PageTableEntry *entry = pageTable.find(reference->page);
+                if (entry != nullptr && entry->present())
+                {
+                    frame = entry->frame();
+                    if (tlb != nullptr) tlb->fill(reference->page, frame);
+                }
+            }
+
+            if (frame >= 0)
+            {
+                frames[frame].entry->touch(write);
+                policy.onHit(frame, *reference);
+                if (frames[frame].prefetched)
+                {
+                    frames[frame].prefetched = false;
+                    prefetch(prefetcher->onPrefetchHit(reference->page), frame, *reference);
+                }
+                continue;
+            }
+
+            // Page fault: la página no está en memoria
+            pageFaults++;
+            frame = load(*reference, write);
+            if (tlb != nullptr) tlb->fill(reference->page, frame);
+            if (prefetcher != nullptr) prefetch(prefetcher->onFault(reference->page), frame, *reference);
+        }
+    }
+
+    // Carga la pagina en un marco libre o en el que desaloja la politica y devuelve el marco.
+    // Si la politica elige pinnedFrame (el de la referencia en curso, durante un readahead) el
+    // marco se le devuelve como recien cargado con pinnedReference y no se carga nada: -1
+    int load(const MemoryReference &reference, bool write, int pinnedFrame = -1, const MemoryReference *pinnedReference = nullptr)
+    {
+        int frame;
+        if ((int)frames.size() < numFrames)
+        {
+            frame = frames.size();
+            frames.push_back(MemoryMapping());
+        }
+        else
+        {
+            // Se debe reemplazar una página: la politica elige el marco
+            frame = policy.chooseVictim(reference);
+            if (frame == pinnedFrame)
+            {
+                frames[frame].entry->touch(false);
+                policy.onMiss(frame, *pinnedReference);
+                return -1;
+            }
+            if (tlb != nullptr) tlb->invalidate(frames[frame].page);
+            dirtyEvictions += frames[frame].entry->dirty();
+            frames[frame].entry->unmap();
+            if (frames[frame].prefetched) prefetcher->wasted++;
+            replace++;
+        }
+
+        // Agregar la nueva página a la tabla y al marco
+        MemoryMapping &mapping = frames[frame];
+        mapping.page = reference.page;
+        mapping.frame = frame;
+        mapping.entry = &pageTable.entry(reference.page);
+        mapping.prefetched = false;
+        mapping.entry->map(frame, write);
+        policy.onMiss(frame, reference);
+        return frame;
+    }
+
+    // Trae por adelantado las paginas sugeridas que no esten en memoria. La pagina de la referencia
+    // en curso (demandFrame) no puede desalojarse: si la politica la elige, la rafaga termina
+    void prefetch(const vector<uint64_t> &pages, int demandFrame, const MemoryReference &demand)
+    {
+        int loaded = 0;
+        for (uint64_t page : pages)
+        {
+            if (loaded == numFrames - 1) break;
+            pageTableLookups++;
+            PageTableEntry *entry = pageTable.find(page);
+            if (entry != nullptr && entry->present()) continue;
+
+            MemoryReference reference;
+            reference.address = 0; // Las politicas solo usan la pagina y la operacion
+            reference.page = page;
+            reference.operation = 'R';
+            int frame = load(reference, false, demandFrame, &demand);
+            if (frame < 0) break;
+            frames[frame].prefetched = true;
+            prefetcher->issued++;
+            loaded++;
+        }
+    }
+};
+
+template <typename Policy, typename... Args>
+uint64_t simulatePageFaults(const vector<MemoryReference> &memoryTrace, int numFrames, uint64_t &replacements, Args &&...args)
+{
+    PageReplacementSimulator<Policy> simulator(numFrames, std::forward<Args>(args)...);
+    simulator.simulate(memoryTrace.data(), memoryTrace.data() + memoryTrace.size());
+
+    replacements = simulator.replace;
+
+    return simulator.pageFaults;
+}
+
+// Enlaces de un nodo dentro de una lista intrusiva indexada
+struct ListLinks
+{
+    int prev = -1;
+    int next = -1;
+};
+
+// Lista doblemente enlazada intrusiva sobre indices (marcos o entradas de historia); los enlaces
+// viven en un vector aparte para que un mismo indice pueda estar en varias listas a la vez (LIRS)
+struct IndexList
+{
+    int head = -1; // Extremo LRU / mas antiguo
+    int tail = -1; // Extremo MRU / mas reciente
+    int size = 0;
+
+    void pushBack(vector<ListLinks> &links, int node)
+    {
+        links[node].prev = tail;
+        links[node].next = -1;
+        if (tail != -1) links[tail].next = node; else head = node;
+        tail = node;
+        size++;
+    }
+
+    void remove(vector<ListLinks> &links, int node)
+    {
+        if (links[node].prev != -1) links[links[node].prev].next = links[node].next; else head = links[node].next;
+        if (links[node].next != -1) links[links[node].next].prev = links[node].prev; else tail = links[node].prev;
+        size--;
+    }
+
+    int popFront(vector<ListLinks> &links)
+    {
+        int node = head;
+        remove(links, node);
+        return node;
+    }
+
+    // newNode ocupa la posicion de oldNode en la lista
+    void replace(vector<ListLinks> &links, int oldNode, int newNode)
+    {
+        links[newNode] = links[oldNode];
+        if (links[newNode].prev != -1) links[links[newNode].prev].next = newNode; else head = newNode;
+        if (links[newNode].next != -1) links[links[newNode].next].prev = newNode; else tail = newNode;
+    }
+};
+
+// FIFO: los marcos se llenan en orden, asi la pagina mas antigua siempre esta bajo la aguja
+struct FIFOPolicy
+{
+    int numFrames;
+    int hand = 0;
+
+    explicit FIFOPolicy(int frames) : numFrames(frames) {}
+
+    void onHit(int, const MemoryReference &) {}
+    void onMiss(int, const MemoryReference &) {}
+
+    int chooseVictim(const MemoryReference &)
+    {
+        int victim = hand;
+        hand = (hand + 1) % numFrames;
+        return victim;
+    }
+};
+
+// LRU: lista intrusiva de marcos, un hit mueve el marco al final en O(1) sin reservar memoria
+struct LRUPolicy
+{
+    vector<ListLinks> links;
+    IndexList order; // Cabeza: menos recientemente usado
+
+    explicit LRUPolicy(int frames) : links(frames) {}
+
+    void onHit(int frame, const MemoryReference &)
+    {
+        if (frame == order.tail) return;
+        order.remove(links, frame);
+        order.pushBack(links, frame);
+    }
+
+    void onMiss(int frame, const MemoryReference &)
+    {
+        order.pushBack(links, frame);
+    }
+
+    int chooseVictim(const MemoryReference &)
+    {
+        return order.popFront(links);
+    }
+};
+
+// Variantes del algoritmo del reloj sobre un arreglo circular fijo de marcos
+enum class ClockVariant
+{
+    SecondChance, // Clock clasico: el bit de referencia da una segunda oportunidad
+    GClock,       // GCLOCK: contador por marco que se decrementa al pasar la aguja
+    Enhanced      // Segunda oportunidad mejorada: clases (referenciado, modificado)
+};
+
+const int GCLOCK_MAX_COUNT = 3; // Tope del contador de GCLOCK para acotar las vueltas de la aguja
+
+// Familia Clock: una aguja circular sobre los marcos. Los bits de referencia y modificacion son los
+// de la PTE de cada marco (el simulador los pone en cada acceso); la aguja los lee y los limpia
+template <ClockVariant Variant>
+struct ClockPolicy
+{
+    const vector<MemoryMapping> *frames = nullptr; // Marcos del simulador, via attachFrames
+    vector<int> count; // Contador de GCLOCK
+    int numFrames;
+    int hand = 0;
+
+    explicit ClockPolicy(int frameCount) : count(frameCount), numFrames(frameCount) {}
+
+    PageTableEntry &entry(int frame)
+    {
+        return *(*frames)[frame].entry;
+    }
+
+    void advance()
+    {
+        hand = (hand + 1) % numFrames;
+    }
+
+    int takeHand()
+    {
+        int victim = hand;
+        advance();
+        return victim;
+    }
+
+    void onHit(int frame, const MemoryReference &)
+    {
+        count[frame] = min(count[frame] + 1, GCLOCK_MAX_COUNT);
+    }
+
+    void onMiss(int frame, const MemoryReference &)
+    {
+        count[frame] = 1;
+    }
+
+    int chooseVictim(const MemoryReference &)
+    {
+        if (Variant == ClockVariant::SecondChance)
+        {
+            while (entry(hand).referenced())
+            {
+                entry(hand).clearReferenced();
+                advance();
+            }
+        }
+        else if (Variant == ClockVariant::GClock)
+        {
+            while (count[hand] > 0)
+            {
+                count[hand]--;
+                advance();
+            }
+        }
+        else
+        {
+            // Primera vuelta busca (0,0) sin tocar bits; la segunda busca (0,1) limpiando el bit
+            // de referencia; tras ambas todas las paginas quedan sin referencia y se repite
+            while (true)
+            {
+                for (int step = 0; step < numFrames; step++, advance())
+                {
+                    if (!entry(hand).referenced() && !entry(hand).dirty()) return takeHand();
+                }
+                for (int step = 0; step < numFrames; step++, advance())
+                {
+                    if (!entry(hand).referenced() && entry(hand).dirty()) return takeHand();
+                    entry(hand).clearReferenced();
+                }
+            }
+        }
+        return takeHand();
+    }
+};
+
+template <ClockVariant Variant>
+void attachFrames(ClockPolicy<Variant> &policy, const vector<MemoryMapping> &frames)
+{
+    policy.frames = &frames;
+}
+
+// Entrada de las politicas con historia: indices [0, numFrames) son los marcos residentes y
+// desde numFrames las paginas fantasma (solo historia, no ocupan marco)
+struct PolicyEntry
+{
+    uint64_t page;
+    int list; // Lista o estado al que pertenece (depende de la politica)
+};
+
+// Pool de entradas con lista de libres para los fantasmas: se reserva al construir y se
+// reutiliza, asi las politicas no reservan memoria por referencia
+struct PolicyEntryPool
+{
+    vector<PolicyEntry> entries;
+    vector<ListLinks> links;
+    vector<int> freeGhosts;
+    FlatPageMap<int> ghostIndex; // Pagina fantasma -> entrada
+
+    PolicyEntryPool(int numFrames, int maxGhosts)
+        : entries(numFrames + maxGhosts), links(numFrames + maxGhosts)
+    {
+        for (int entry = numFrames + maxGhosts; entry-- > numFrames;) freeGhosts.push_back(entry);
+        ghostIndex.reserve(maxGhosts);
+    }
+
+    int findGhost(uint64_t page) const
+    {
+        const int *entry = ghostIndex.find(page);
+        return entry == nullptr ? -1 : *entry;
+    }
+
+    int createGhost(uint64_t page, int list)
+    {
+        int entry;
+        if (!freeGhosts.empty())
+        {
+            entry = freeGhosts.back();
+            freeGhosts.pop_back();
+        }
+        else
+        {
+            entry = entries.size();
+            entries.push_back(PolicyEntry());
+            links.push_back(ListLinks());
+        }
+        entries[entry].page = page;
+        entries[entry].list = list;
+        ghostIndex[page] = entry;
+        return entry;
+    }
+
+    void destroyGhost(int entry)
+    {
+        ghostIndex.erase(entries[entry].page);
+        freeGhosts.push_back(entry);
+    }
+};
+
+// ARC (Megiddo y Modha): T1/T2 residentes (vistas una vez / varias veces) y B1/B2 fantasmas.
+// El objetivo p para |T1| se adapta segun en que historia caen los fallos
+struct ARCPolicy
+{
+    enum { T1, T2, B1, B2 };
+
+    PolicyEntryPool pool;
+    IndexList lists[4];
+    int numFrames;
+    int target = 0; // p: tamaño objetivo de T1
+
+    explicit ARCPolicy(int frames) : pool(frames, frames + 1), numFrames(frames) {}
+
+    void onHit(int frame, const MemoryReference &)
+    {
+        // Hit: pasa a la posicion MRU de T2
+        lists[pool.entries[frame].list].remove(pool.links, frame);
+        pool.entries[frame].list = T2;
+        lists[T2].pushBack(pool.links, frame);
+    }
+
+    // Desaloja el LRU de T1 o de T2 dejando su pagina en la historia fantasma
+    int demote(bool inB2)
+    {
+        int t1 = lists[T1].size;
+        int from = (t1 >= 1 && ((inB2 && t1 == target) || t1 > target)) ? T1 : T2;
+        int frame = lists[from].popFront(pool.links);
+        int ghost = pool.createGhost(pool.entries[frame].page, from == T1 ? B1 : B2);
+        lists[pool.entries[ghost].list].pushBack(pool.links, ghost);
+        return frame;
+    }
+
+    void dropGhost(int list)
+    {
+        pool.destroyGhost(lists[list].popFront(pool.links));
+    }
+
+    int chooseVictim(const MemoryReference &reference)
+    {
+        int ghost = pool.findGhost(reference.page);
+        int list = ghost == -1 ? -1 : pool.entries[ghost].list;
+        int b1 = lists[B1].size, b2 = lists[B2].size;
+
+        if (list == B1)
+        {
+            target = min(numFrames, target + max(b2 / b1, 1));
+            return demote(false);
+        }
+        if (list == B2)
+        {
+            target = max(0, target - max(b1 / b2, 1));
+            return demote(true);
+        }
+
+        if (lists[T1].size + b1 == numFrames)
+        {
+            if (lists[T1].size < numFrames)
+            {
+                dropGhost(B1);
+                return demote(false);
+            }
+            // T1 ocupa toda la memoria: se descarta su LRU sin dejar historia
+            return lists[T1].popFront(pool.links);
+        }
+        if (lists[T1].size + lists[T2].size + b1 + b2 == 2 * numFrames) dropGhost(B2);
+        return demote(false);
+    }
+
+    void onMiss(int frame, const MemoryReference &reference)
+    {
+        pool.entries[frame].page = reference.page;
+        int ghost = pool.findGhost(reference.page);
+
+        if (ghost != -1)
+        {
+            // Estaba en B1 o B2: vuelve directo a T2
+            lists[pool.entries[ghost].list].remove(pool.links, ghost);
+            pool.destroyGhost(ghost);
+            pool.entries[frame].list = T2;
+        }
+        else
+        {
+            pool.entries[frame].list = T1;
+        }
+        lists[pool.entries[frame].list].pushBack(pool.links, frame);
+    }
+};
+
+// 2Q (Johnson y Shasha): A1in es una FIFO residente para paginas vistas una vez, A1out su
+// historia fantasma y Am una LRU residente para las paginas que volvieron a usarse
+struct TwoQPolicy
+{
+    enum { A1in, A1out, Am };
+
+    PolicyEntryPool pool;
+    IndexList lists[3];
+    int maxIn;  // Kin: 25% de los marcos
+    int maxOut; // Kout: historia de 50% de los marcos
+
+    explicit TwoQPolicy(int frames)
+        : pool(frames, max(1, frames / 2) + 1), maxIn(max(1, frames / 4)), maxOut(max(1, frames / 2)) {}
+
+    void onHit(int frame, const MemoryReference &)
+    {
+        // En Am se actualiza la posicion LRU; en A1in no se mueve
+        if (pool.entries[frame].list == Am)
+        {
+            lists[Am].remove(pool.links, frame);
+            lists[Am].pushBack(pool.links, frame);
+        }
+    }
+
+    int chooseVictim(const MemoryReference &)
+    {
+        if (lists[A1in].size > maxIn || lists[Am].size == 0)
+        {
+            int frame = lists[A1in].popFront(pool.links);
+            int ghost = pool.createGhost(pool.entries[frame].page, A1out);
+            lists[A1out].pushBack(pool.links, ghost);
+            if (lists[A1out].size > maxOut) pool.destroyGhost(lists[A1out].popFront(pool.links));
+            return frame;
+        }
+        return lists[Am].popFront(pool.links);
+    }
+
+    void onMiss(int frame, const MemoryReference &reference)
+    {
+        pool.entries[frame].page = reference.page;
+        int ghost = pool.findGhost(reference.page);
+
+        if (ghost != -1)
+        {
+            // Volvio a usarse poco despues de salir de A1in: pasa a Am
+            lists[A1out].remove(pool.links, ghost);
+            pool.destroyGhost(ghost);
+            pool.entries[frame].list = Am;
+        }
+        else
+        {
+            pool.entries[frame].list = A1in;
+        }
+        lists[pool.entries[frame].list].pushBack(pool.links, frame);
+    }
+};
+
+// LIRS (Jiang y Zhang): las paginas con menor distancia de reuso (LIR) ocupan casi toda la
+// memoria; las HIR residentes viven en la cola Q y son las unicas candidatas a desalojo.
+// La pila S guarda la recencia de LIR, HIR residentes y HIR no residentes (fantasmas)
+struct LIRSPolicy
+{
+    enum { LIR, HIR, HIRGhost };
+
+    PolicyEntryPool pool;         // pool.links son los enlaces de la pila S
+    vector<ListLinks> queueLinks; // Enlaces en Q (HIR residentes)
+    vector<ListLinks> ghostLinks; // Enlaces en la lista de fantasmas, para acotarla
+    vector<char> inStack;
+    IndexList stack;
+    IndexList queue;
+    IndexList ghosts;
+    int numFrames;
+    int maxLIR;
+    int numLIR = 0;
+
+    explicit LIRSPolicy(int frames)
+        : pool(frames, frames + 1), queueLinks(frames), ghostLinks(2 * frames + 1), inStack(2 * frames + 1),
+          numFrames(frames), maxLIR(max(1, frames - max(1, frames / 100))) {}
+
+    void pushStack(int entry)
+    {
+        if (inStack[entry]) stack.remove(pool.links, entry);
+        stack.pushBack(pool.links, entry);
+        inStack[entry] = true;
+    }
+
+    // Quita de la base de S las entradas HIR hasta que la base sea LIR
+    void prune()
+    {
+        while (stack.head != -1 && pool.entries[stack.head].list != LIR)
+        {
+            int entry = stack.popFront(pool.links);
+            inStack[entry] = false;
+            if (pool.entries[entry].list == HIRGhost)
+            {
+                ghosts.remove(ghostLinks, entry);
+                pool.destroyGhost(entry);
+            }
+        }
+    }
+
+    // La LIR de la base de S pasa a HIR residente al final de Q
+    void demoteBottomLIR()
+    {
+        int frame = stack.popFront(pool.links);
+        inStack[frame] = false;
+        pool.entries[frame].list = HIR;
+        queue.pushBack(queueLinks, frame);
+        numLIR--;
+        prune();
+    }
+
+    void promote(int frame)
+    {
+        pool.entries[frame].list = LIR;
+        numLIR++;
+        pushStack(frame);
+        if (numLIR > maxLIR) demoteBottomLIR();
+    }
+
+    void onHit(int frame, const MemoryReference &)
+    {
+        if (pool.entries[frame].list == LIR)
+        {
+            // Hit en LIR: pasa al tope de S
+            bool wasBottom = stack.head == frame;
+            pushStack(frame);
+            if (wasBottom) prune();
+        }
+        else if (inStack[frame])
+        {
+            // HIR en S: su distancia de reuso es menor que la de la LIR mas vieja, pasa a LIR
+            queue.remove(queueLinks, frame);
+            promote(frame);
+        }
+        else
+        {
+            pushStack(frame);
+            queue.remove(queueLinks, frame);
+            queue.pushBack(queueLinks, frame);
+        }
+    }
+
+    int chooseVictim(const MemoryReference &)
+    {
+        if (queue.size == 0) demoteBottomLIR();
+        int victim = queue.popFront(queueLinks);
+
+        if (inStack[victim])
+        {
+            // Queda como fantasma en su posicion de S; la cantidad de fantasmas se acota
+            int ghost = pool.createGhost(pool.entries[victim].page, HIRGhost);
+            if ((size_t)ghost >= inStack.size())
+            {
+                inStack.resize(ghost + 1);
+                ghostLinks.resize(ghost + 1);
+            }
+            stack.replace(pool.links, victim, ghost);
+            inStack[ghost] = true;
+            inStack[victim] = false;
+            ghosts.pushBack(ghostLinks, ghost);
+            if (ghosts.size > numFrames)
+            {
+                int oldest = ghosts.popFront(ghostLinks);
+                stack.remove(pool.links, oldest);
+                inStack[oldest] = false;
+                pool.destroyGhost(oldest);
+            }
+        }
+        return victim;
+    }
+
+    void onMiss(int frame, const MemoryReference &reference)
+    {
+        pool.entries[frame].page = reference.page;
+        int ghost = pool.findGhost(reference.page);
+
+        if (ghost != -1)
+        {
+            // Estaba en la historia de S: vuelve como LIR
+            ghosts.remove(ghostLinks, ghost);
+            stack.remove(pool.links, ghost);
+            inStack[ghost] = false;
+            pool.destroyGhost(ghost);
+            promote(frame);
+        }
+        else if (numLIR < maxLIR)
+        {
+            // Mientras el conjunto LIR no esta lleno las paginas nuevas entran como LIR
+            pool.entries[frame].list = LIR;
+            numLIR++;
+            pushStack(frame);
+        }
+        else
+        {
+            pool.entries[frame].list = HIR;
+            pushStack(frame);
+            queue.pushBack(queueLinks, frame);
+        }
+    }
+};
+
+uint64_t simulatePageFaultsFIFO(const vector<MemoryReference> &memoryTrace, int numFrames, uint64_t &replacements)
+{
+    return simulatePageFaults<FIFOPolicy>(memoryTrace, numFrames, replacements);
+}
+
+uint64_t simulatePageFaultsLRU(const vector<MemoryReference> &memoryTrace, int numFrames, uint64_t &replacement)
+{
+    return simulatePageFaults<LRUPolicy>(memoryTrace, numFrames, replacement);
+}
+
+uint64_t simulatePageFaultsCLOCK(const vector<MemoryReference> &memoryTrace, int numFrames, uint64_t &replacements)
+{
+    return simulatePageFaults<ClockPolicy<ClockVariant::SecondChance>>(memoryTrace, numFrames, replacements);
+}
+
+uint64_t simulatePageFaultsGCLOCK(const vector<MemoryReference> &memoryTrace, int numFrames, uint64_t &replacements)
+{
+    return simulatePageFaults<ClockPolicy<ClockVariant::GClock>>(memoryTrace, numFrames, replacements);
+}
+
+uint64_t simulatePageFaultsESC(const vector<MemoryReference> &memoryTrace, int numFrames, uint64_t &replacements)
+{
+    return simulatePageFaults<ClockPolicy<ClockVariant::Enhanced>>(memoryTrace, numFrames, replacements);
+}
+
+uint64_t simulatePageFaultsARC(const vector<MemoryReference> &memoryTrace, int numFrames, uint64_t &replacements)
+{
+    return simulatePageFaults<ARCPolicy>(memoryTrace, numFrames, replacements);
+}
+
+uint64_t simulatePageFaults2Q(const vector<MemoryReference> &memoryTrace, int numFrames, uint64_t &replacements)
+{
+    return simulatePageFaults<TwoQPolicy>(memoryTrace, numFrames, replacements);
+}
+
+uint64_t simulatePageFaultsLIRS(const vector<MemoryReference> &memoryTrace, int numFrames, uint64_t &replacements)
+{
+    return simulatePageFaults<LIRSPolicy>(memoryTrace, numFrames, replacements);
+}
+
+// Arbol de Fenwick sobre posiciones de tiempo: suma de prefijos y actualizacion en O(log n)
+struct FenwickTree
+{
+    vector<int> tree;
+
+    void reset(size_t size)
+    {
+        tree.assign(size, 0);
+    }
+
+    void add(size_t index, int delta)
+    {
+        for (; index < tree.size(); index |= index + 1) tree[index] += delta;
+    }
+
+    // Suma de [0, index)
+    int prefix(size_t index) const
+    {
+        int sum = 0;
+        for (; index > 0; index &= index - 1) sum += tree[index - 1];
+        return sum;
+    }
+};
+
+// Analizador de distancias de pila (Mattson): como LRU cumple la propiedad de inclusion, una
+// sola pasada da los fallos LRU exactos para cualquier cantidad de marcos. Cada pagina deja una
+// marca en el instante de su ultimo acceso; la distancia de reuso es la cantidad de marcas
+// posteriores a ese instante mas uno. Los instantes se renumeran cuando el arbol se llena, asi
+// el costo es O(log M) por referencia y la memoria O(M), con M paginas distintas.
+// Tambien cuenta las escrituras a disco de LRU para todas las cantidades de marcos: una pagina
+// esta sucia con F marcos si no fue desalojada desde su ultima escritura, es decir si F es al
+// menos la mayor distancia de sus accesos posteriores a esa escritura (cleanDistance)
+struct StackDistanceAnalyzer
+{
+    struct PageHistory
+    {
+        size_t time;          // Instante del ultimo acceso
+        size_t cleanDistance; // Sucia para F >= cleanDistance; SIZE_MAX si nunca se escribio
+    };
+
+    FlatPageMap<PageHistory> lastAccess; // Pagina -> historia de accesos
+    FenwickTree marks;
+    size_t now = 0;
+    vector<uint64_t> distanceCount;  // distanceCount[d]: referencias con distancia de pila d
+    vector<int64_t> writeBackDelta;  // Diferencias de write-backs por cantidad de marcos
+    uint64_t coldMisses = 0;
+    uint64_t references = 0;
+    uint64_t writes = 0;
+
+    StackDistanceAnalyzer()
+    {
+        marks.reset(1024);
+    }
+
+    void simulate(const MemoryReference *begin, const MemoryReference *end)
+    {
+        for (const MemoryReference *reference = begin; reference != end; reference++)
+        {
+            if (now == marks.tree.size()) compact();
+
+            bool write = (reference->operation == 'W');
+            references++;
+            writes += write;
+            PageHistory *found = lastAccess.find(reference->page);
+
+            if (found == nullptr)
+            {
+                // Primer acceso: fallo obligatorio para cualquier cantidad de marcos
+                coldMisses++;
+                PageHistory history;
+                history.time = now;
+                history.cleanDistance = write ? 0 : SIZE_MAX;
+                lastAccess[reference->page] = history;
+            }
+            else
+            {
+                PageHistory &history = *found;
+                size_t distance = marks.prefix(now) - marks.prefix(history.time + 1) + 1;
+                if (distance >= distanceCount.size())
+                {
+                    distanceCount.resize(distance + 1, 0);
+                    writeBackDelta.resize(distance + 1, 0);
+                }
+                distanceCount[distance]++;
+
+                // Con F < distance la pagina fue desalojada desde el acceso anterior; si estaba
+                // sucia (F >= cleanDistance) hubo una escritura a disco
+                size_t dirtyFrom = max<size_t>(history.cleanDistance, 1);
+                if (dirtyFrom < distance)
+                {
+                    writeBackDelta[dirtyFrom]++;
+                    writeBackDelta[distance]--;
+                }
+                history.cleanDistance = write ? 0 : max(history.cleanDistance, distance);
+
+                marks.add(history.time, -1);
+                history.time = now;
+            }
+            marks.add(now, 1);
+            now++;
+        }
+    }
+
+    // Renumera los ultimos accesos vivos a 0..M-1 conservando su orden
+    void compact()
+    {
+        vector<pair<size_t, uint64_t>> live;
+        live.reserve(lastAccess.size());
+        lastAccess.forEach([&](uint64_t page, const PageHistory &history) { live.push_back(make_pair(history.time, page)); });
+        sort(live.begin(), live.end());
+
+        marks.reset(max<size_t>(2 * live.size(), 1024));
+        for (size_t i = 0; i < live.size(); i++)
+        {
+            lastAccess.find(live[i].second)->time = i;
+            marks.add(i, 1);
+        }
+        now = live.size();
+    }
+
+    // Curva de fallos: faults[F] es la cantidad de page faults de LRU con F marcos, F = 0..M
+    vector<uint64_t> missCurve() const
+    {
+        size_t distinctPages = lastAccess.size();
+        vector<uint64_t> faults(distinctPages + 1, coldMisses);
+        uint64_t farther = 0; // Referencias con distancia mayor que F
+        for (size_t frames = distinctPages + 1; frames-- > 0;)
+        {
+            faults[frames] += farther;
+            if (frames < distanceCount.size()) farther += distanceCount[frames];
+        }
+        faults[0] = references;
+        return faults;
+    }
+
+    // writeBacks[F]: paginas sucias desalojadas por LRU con F marcos, F = 0..M
+    vector<uint64_t> writeBackCurve() const
+    {
+        // Ademas de los desalojos vistos al reusar una pagina, las que no se vuelven a usar salen
+        // de memoria si su profundidad final en la pila supera F
+        vector<pair<size_t, size_t>> finalStack; // (ultimo acceso, cleanDistance)
+        finalStack.reserve(lastAccess.size());
+        lastAccess.forEach([&](uint64_t, const PageHistory &history) { finalStack.push_back(make_pair(history.time, history.cleanDistance)); });
+        sort(finalStack.rbegin(), finalStack.rend());
+
+        vector<int64_t> delta(writeBackDelta);
+        delta.resize(max(delta.size(), finalStack.size() + 1), 0);
+        for (size_t i = 0; i < finalStack.size(); i++)
+        {
+            size_t depth = i + 1;
+            size_t dirtyFrom = max<size_t>(finalStack[i].second, 1);
+            if (dirtyFrom < depth)
+            {
+                delta[dirtyFrom]++;
+                delta[depth]--;
+            }
+        }
+
+        vector<uint64_t> writeBacks(lastAccess.size() + 1, 0);
+        int64_t running = 0;
+        for (size_t frames = 1; frames < writeBacks.size(); frames++)
+        {
+            running += delta[frames];
+            writeBacks[frames] = running;
+        }
+        return writeBacks;
+    }
+};
+
+// Resultado del analisis de distancias de pila listo para consultar por cantidad de marcos
+struct LRUMissRatioCurve
+{
+    vector<uint64_t> faults;
+    vector<uint64_t> writeBacks;
+    uint64_t references = 0;
+    uint64_t writes = 0;
+
+    explicit LRUMissRatioCurve(const StackDistanceAnalyzer &analyzer)
+        : faults(analyzer.missCurve()), writeBacks(analyzer.writeBackCurve()), references(analyzer.references),
+          writes(analyzer.writes) {}
+
+    uint64_t pageFaults(int numFrames) const
+    {
+        return faults[min((size_t)numFrames, faults.size() - 1)];
+    }
+
+    // Los primeros min(marcos, paginas distintas) fallos llenan marcos libres; el resto reemplaza
+    uint64_t replacements(int numFrames) const
+    {
+        return pageFaults(numFrames) - min((size_t)numFrames, faults.size() - 1);
+    }
+
+    uint64_t dirtyEvictions(int numFrames) const
+    {
+        return writeBacks[min((size_t)numFrames, writeBacks.size() - 1)];
+    }
+};
+
+// Guarda la curva completa en CSV: marcos, fallos, tasa de fallos y escrituras a disco
+void saveMissRatioCurve(const LRUMissRatioCurve &curve, const string &filename)
+{
+    ofstream file(filename);
+
+    file << "frames,page_faults,miss_ratio,write_backs" << endl;
+    for (size_t frames = 1; frames < curve.faults.size(); frames++)
+    {
+        double ratio = curve.references == 0 ? 0.0 : (double)curve.faults[frames] / curve.references;
+        file << frames << "," << curve.faults[frames] << "," << ratio << "," << curve.writeBacks[frames] << "\n";
+    }
+
+    file.close();
+}
+
+// Pre-pass hacia atras: nextUse[i] es el indice de la siguiente referencia a la misma
+// pagina que memoryTrace[i], o memoryTrace.size() si la pagina no vuelve a usarse
+vector<size_t> buildNextUse(const vector<MemoryReference> &memoryTrace)
+{
+    vector<size_t> nextUse(memoryTrace.size());
+    FlatPageMap<size_t> lastSeen;
+
+    for (size_t i = memoryTrace.size(); i-- > 0;)
+    {
+        size_t *seen = lastSeen.find(memoryTrace[i].page);
+        if (seen == nullptr)
+        {
+            nextUse[i] = memoryTrace.size();
+            lastSeen[memoryTrace[i].page] = i;
+        }
+        else
+        {
+            nextUse[i] = *seen;
+            *seen = i;
+        }
+    }
+
+    return nextUse;
+}
+
+// OPT (Belady): desaloja el marco cuya pagina se usara mas lejos en el futuro. Max-heap de
+// (proximo uso, marco); las entradas viejas se descartan al llegar a la cima. Las referencias
+// deben venir del mismo vector que trace, para obtener su indice en nextUse
+struct OPTPolicy
+{
+    const MemoryReference *trace;
+    const vector<size_t> &nextUse;
+    vector<size_t> frameNextUse; // Proximo uso de la pagina de cada marco
+    priority_queue<pair<size_t, int>> nextUseHeap;
+    int usedFrames = 0;
+
+    OPTPolicy(int frames, const MemoryReference *memoryTrace, const vector<size_t> &nextUseIndex)
+        : trace(memoryTrace), nextUse(nextUseIndex), frameNextUse(frames) {}
+
+    void onHit(int frame, const MemoryReference &reference)
+    {
+        size_t next = nextUse[&reference - trace];
+        frameNextUse[frame] = next;
+        nextUseHeap.push(make_pair(next, frame));
+
+        // Compactar el heap cuando las entradas viejas dominan, para mantenerlo en O(frames)
+        if (nextUseHeap.size() > 2 * (size_t)usedFrames + 64)
+        {
+            vector<pair<size_t, int>> live(usedFrames);
+            for (int f = 0; f < usedFrames; f++) live[f] = make_pair(frameNextUse[f], f);
+            nextUseHeap = priority_queue<pair<size_t, int>>(less<pair<size_t, int>>(), move(live));
+        }
+    }
+
+    void onMiss(int frame, const MemoryReference &reference)
+    {
+        usedFrames = max(usedFrames, frame + 1);
+        onHit(frame, reference);
+    }
+
+    int chooseVictim(const MemoryReference &)
+    {
+        while (frameNextUse[nextUseHeap.top().second] != nextUseHeap.top().first) nextUseHeap.pop();
+        int victim = nextUseHeap.top().second;
+        nextUseHeap.pop();
+        return victim;
+    }
+};
+
+// nextUse se recibe ya calculado para compartirlo entre simulaciones con distinta cantidad de marcos
+uint64_t simulatePageFaultsOPT(const vector<MemoryReference> &memoryTrace, const vector<size_t> &nextUse, int numFrames, uint64_t &replacements)
+{
+    return simulatePageFaults<OPTPolicy>(memoryTrace, numFrames, replacements, memoryTrace.data(), nextUse);
+}
+
+uint64_t simulatePageFaultsOPT(const vector<MemoryReference> &memoryTrace, int numFrames, uint64_t &replacements)
+{
+    return simulatePageFaultsOPT(memoryTrace, buildNextUse(memoryTrace), numFrames, replacements);
+}
+
+// Segundos transcurridos desde start
+double secondsSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Una simulacion (algoritmo, marcos) del barrido; el resultado se guarda en el mismo job
+struct SimulationJob
+{
+    string algorithm; // "FIFO", "LRU", "OPT", "CLOCK", "GCLOCK", "ESC", "ARC", "2Q" o "LIRS"
+    int numFrames;
+    uint64_t pageFaults = 0;
+    uint64_t replacements = 0;
+    uint64_t writeBacks = 0; // Paginas sucias desalojadas (escrituras a disco)
+    uint64_t framesUsed = 0; // Marcos ocupados al terminar
+    bool keepFrameMap = false;     // Guardar el mapa de marcos final (--frame-map)
+    vector<pair<uint64_t, bool>> frameMap; // Marco -> (pagina, sucia) al terminar, solo si keepFrameMap
+    TLBHierarchyConfig tlb; // TLB a simular delante de la tabla de paginas, si esta habilitada
+    uint64_t tlbL1Hits = 0;
+    uint64_t tlbL2Hits = 0;
+    uint64_t tlbWalks = 0;
+    PrefetchConfig prefetch; // Readahead al fallar, si esta habilitado (no aplica a OPT)
+    uint64_t prefetches = 0;
+    uint64_t usefulPrefetches = 0;
+    uint64_t wastedPrefetches = 0;
+    uint64_t pageTableLookups = 0;
+    double seconds = 0; // Tiempo de la simulacion
+    bool fromLRUCurve = false; // Leido de la curva LRU: el tiempo es el de la pasada de distancias de pila
+    bool done = false;
+
+    SimulationJob(const string &name, int frames) : algorithm(name), numFrames(frames) {}
+};
+
+// Copia los contadores del simulador (y de su TLB y prefetcher) al job
+template <typename Policy>
+void storeSimulationResults(const PageReplacementSimulator<Policy> &simulator, const TLBHierarchy &tlb,
+                            const Prefetcher &prefetcher, SimulationJob &job)
+{
+    job.pageFaults = simulator.pageFaults;
+    job.replacements = simulator.replace;
+    job.writeBacks = simulator.dirtyEvictions;
+    job.framesUsed = simulator.frames.size();
+    if (job.keepFrameMap)
+    {
+        job.frameMap.clear();
+        for (const MemoryMapping &mapping : simulator.frames) job.frameMap.push_back(make_pair(mapping.page, mapping.entry->dirty()));
+    }
+    job.tlbL1Hits = tlb.l1.hits;
+    job.tlbL2Hits = tlb.l2.hits;
+    job.tlbWalks = tlb.walks;
+    job.prefetches = prefetcher.issued;
+    job.usefulPrefetches = prefetcher.useful;
+    job.wastedPrefetches = prefetcher.wasted;
+    job.pageTableLookups = simulator.pageTableLookups;
+}
+
+// Nombres aceptados por --algorithms (en mayusculas, como se imprimen en la tabla)
+bool isKnownAlgorithm(const string &name)
+{
+    static const char *const known[] = {"FIFO", "LRU", "OPT", "CLOCK", "GCLOCK", "ESC", "ARC", "2Q", "LIRS"};
+    return find(begin(known), end(known), name) != end(known);
+}
+
+// Los despachadores validan con isKnownAlgorithm al parsear; llegar aca es un error del programa
+void failUnknownAlgorithm(const string &name)
+{
+    cerr << "Algoritmo desconocido: " << name << endl;
+    exit(EXIT_FAILURE);
+}
+
+// OPT ya conoce el futuro: el readahead no tiene sentido ahi
+bool usesPrefetch(const SimulationJob &job)
+{
+    return job.prefetch.enabled() && job.algorithm != "OPT";
+}
+
+// La curva LRU solo da fallos, reemplazos y escrituras: con TLB, readahead o mapa de marcos hay
+// que simular
+bool answeredByLRUCurve(const SimulationJob &job)
+{
+    return job.algorithm == "LRU" && !job.tlb.enabled() && !usesPrefetch(job) && !job.keepFrameMap;
+}
+
+// Corre una politica sobre el trace completo y guarda sus contadores en el job
+template <typename Policy, typename... Args>
+void runSimulationJob(const vector<MemoryReference> &memoryTrace, SimulationJob &job, Args &&...args)
+{
+    PageReplacementSimulator<Policy> simulator(job.numFrames, std::forward<Args>(args)...);
+    TLBHierarchy tlb(job.tlb);
+    if (job.tlb.enabled()) simulator.tlb = &tlb;
+    Prefetcher prefetcher(job.prefetch);
+    if (usesPrefetch(job)) simulator.prefetcher = &prefetcher;
+    simulator.simulate(memoryTrace.data(), memoryTrace.data() + memoryTrace.size());
+    storeSimulationResults(simulator, tlb, prefetcher, job);
+}
+
+// Despacha el job a su politica. nextUse es el pre-pass de OPT y, si hay curva LRU, las filas LRU
+// sin TLB, readahead ni mapa de marcos se leen de ella
+void runSimulationJob(const vector<MemoryReference> &memoryTrace, SimulationJob &job, const vector<size_t> &nextUse,
+                      const LRUMissRatioCurve *lruCurve)
+{
+    if (job.algorithm == "FIFO") runSimulationJob<FIFOPolicy>(memoryTrace, job);
+    else if (lruCurve != nullptr && answeredByLRUCurve(job))
+    {
+        job.pageFaults = lruCurve->pageFaults(job.numFrames);
+        job.replacements = lruCurve->replacements(job.numFrames);
+        job.writeBacks = lruCurve->dirtyEvictions(job.numFrames);
+        job.framesUsed = min<uint64_t>(job.numFrames, lruCurve->faults.size() - 1); // Paginas distintas
+        job.fromLRUCurve = true;
+    }
+    else if (job.algorithm == "LRU") runSimulationJob<LRUPolicy>(memoryTrace, job);
+    else if (job.algorithm == "OPT") runSimulationJob<OPTPolicy>(memoryTrace, job, memoryTrace.data(), nextUse);
+    else if (job.algorithm == "CLOCK") runSimulationJob<ClockPolicy<ClockVariant::SecondChance>>(memoryTrace, job);
+    else if (job.algorithm == "GCLOCK") runSimulationJob<ClockPolicy<ClockVariant::GClock>>(memoryTrace, job);
+    else if (job.algorithm == "ESC") runSimulationJob<ClockPolicy<ClockVariant::Enhanced>>(memoryTrace, job);
+    else if (job.algorithm == "ARC") runSimulationJob<ARCPolicy>(memoryTrace, job);
+    else if (job.algorithm == "2Q") runSimulationJob<TwoQPolicy>(memoryTrace, job);
+    else if (job.algorithm == "LIRS") runSimulationJob<LIRSPolicy>(memoryTrace, job);
+    else failUnknownAlgorithm(job.algorithm);
+}
+
+// Corre los jobs pendientes en numThreads hilos sobre el trace compartido de solo lectura.
+// Cada hilo toma el siguiente job libre y escribe solo en su job, asi el orden de resultados
+// no depende de la planificacion. Devuelve los segundos del pre-pass de OPT
+double runSimulationSweep(const vector<MemoryReference> &memoryTrace, vector<SimulationJob> &jobs, int numThreads,
+                          const LRUMissRatioCurve *lruCurve)
+{
+    vector<size_t> pending;
+    bool needsNextUse = false;
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        if (jobs[i].done) continue;
+        pending.push_back(i);
+        needsNextUse = needsNextUse || jobs[i].algorithm == "OPT";
+    }
+
+    // El pre-pass de OPT es comun a todas las cantidades de marcos
+    vector<size_t> nextUse;
+    auto start = chrono::steady_clock::now();
+    if (needsNextUse) nextUse = buildNextUse(memoryTrace);
+    double nextUseSeconds = secondsSince(start);
+
+    atomic<size_t> nextJob(0);
+    auto worker = [&]()
+    {
+        for (size_t k = nextJob++; k < pending.size(); k = nextJob++)
+        {
+            auto jobStart = chrono::steady_clock::now();
+            runSimulationJob(memoryTrace, jobs[pending[k]], nextUse, lruCurve);
+            jobs[pending[k]].seconds = secondsSince(jobStart);
+            jobs[pending[k]].done = true;
+        }
+    };
+
+    vector<thread> workers;
+    int extraThreads = min<int>(numThreads, pending.size()) - 1;
+    for (int t = 0; t < extraThreads; t++) workers.emplace_back(worker);
+    worker();
+    for (thread &t : workers) t.join();
+    return nextUseSeconds;
+}
+
+// Corre un simulador en linea sobre el lector y guarda el resultado en el job
+template <typename Policy>
+void streamSimulationJob(TraceReader &reader, SimulationJob &job)
+{
+    auto start = chrono::steady_clock::now();
+    PageReplacementSimulator<Policy> simulator(job.numFrames);
+    TLBHierarchy tlb(job.tlb);
+    if (job.tlb.enabled()) simulator.tlb = &tlb;
+    Prefetcher prefetcher(job.prefetch);
+    if (usesPrefetch(job)) simulator.prefetcher = &prefetcher;
+    streamMemoryTrace(reader, simulator);
+    storeSimulationResults(simulator, tlb, prefetcher, job);
+    job.seconds = secondsSince(start);
+    job.done = true;
+}
+
+// Simula el job en streaming si su algoritmo es en linea; OPT y LRU (curva) quedan pendientes.
+// Si la curva no alcanza (TLB, readahead o mapa de marcos), LRU tambien se simula en linea
+void streamSimulationJob(TraceReader &reader, SimulationJob &job)
+{
+    if (job.algorithm == "FIFO") streamSimulationJob<FIFOPolicy>(reader, job);
+    else if (job.algorithm == "LRU" && !answeredByLRUCurve(job)) streamSimulationJob<LRUPolicy>(reader, job);
+    else if (job.algorithm == "CLOCK") streamSimulationJob<ClockPolicy<ClockVariant::SecondChance>>(reader, job);
+    else if (job.algorithm == "GCLOCK") streamSimulationJob<ClockPolicy<ClockVariant::GClock>>(reader, job);
+    else if (job.algorithm == "ESC") streamSimulationJob<ClockPolicy<ClockVariant::Enhanced>>(reader, job);
+    else if (job.algorithm == "ARC") streamSimulationJob<ARCPolicy>(reader, job);
+    else if (job.algorithm == "2Q") streamSimulationJob<TwoQPolicy>(reader, job);
+    else if (job.algorithm == "LIRS") streamSimulationJob<LIRSPolicy>(reader, job);
+    else if (!isKnownAlgorithm(job.algorithm)) failUnknownAlgorithm(job.algorithm);
+}
+
+// Modo multiproceso: varios traces se intercalan por quantum y comparten los marcos fisicos.
+// Las paginas de cada proceso se etiquetan con su pid en los bits altos para no colisionar
+const int PROCESS_ID_SHIFT = 56;
+
+enum class FrameAllocation
+{
+    Fixed,        // Partes iguales
+    Proportional, // Segun la cantidad de paginas distintas del proceso
+    Priority      // Segun la prioridad del proceso
+};
+
+struct ProcessTrace
+{
+    string name;
+    vector<MemoryReference> trace;
+    int priority = 1;
+    size_t distinctPages = 0;
+};
+
+// Tramo contiguo del trace intercalado que corre un mismo proceso
+struct ProcessSlice
+{
+    int pid;
+    size_t begin;
+    size_t end;
+};
+
+struct ProcessResult
+{
+    int frames = 0; // Asignados (local) o residentes al terminar (global)
+    uint64_t pageFaults = 0;
+    uint64_t writeBacks = 0;
+};
+
+// Carga cada trace con sus paginas etiquetadas por pid
+bool loadProcessTraces(vector<ProcessTrace> &processes, int numAddresses, int numThreads, int pageSizeBits)
+{
+    for (size_t pid = 0; pid < processes.size(); pid++)
+    {
+        ProcessTrace &process = processes[pid];
+        loadMemoryTrace(process.name, process.trace, numAddresses, numThreads);
+        if (process.trace.empty())
+        {
+            cerr << "No se pudo leer el trace " << process.name << endl;
+            return false;
+        }
+        applyPageSize(process.trace.data(), process.trace.data() + process.trace.size(), pageSizeBits);
+
+        RadixPageTable seen;
+        for (MemoryReference &reference : process.trace)
+        {
+            reference.page |= (uint64_t)pid << PROCESS_ID_SHIFT;
+            PageTableEntry &entry = seen.entry(reference.page);
+            process.distinctPages += !entry.present();
+            entry.map(0, false);
+        }
+    }
+    return true;
+}
+
+// Planificador round-robin: cada proceso corre quantum referencias por turno hasta agotar su trace
+vector<MemoryReference> interleaveProcesses(const vector<ProcessTrace> &processes, size_t quantum, vector<ProcessSlice> &slices)
+{
+    vector<MemoryReference> interleaved;
+    vector<size_t> position(processes.size(), 0);
+    size_t total = 0;
+    for (const ProcessTrace &process : processes) total += process.trace.size();
+    interleaved.reserve(total);
+
+    while (interleaved.size() < total)
+    {
+        for (size_t pid = 0; pid < processes.size(); pid++)
+        {
+            const vector<MemoryReference> &trace = processes[pid].trace;
+            size_t count = min(quantum, trace.size() - position[pid]);
+            if (count == 0) continue;
+            slices.push_back(ProcessSlice{(int)pid, interleaved.size(), interleaved.size() + count});
+            interleaved.insert(interleaved.end(), trace.begin() + position[pid], trace.begin() + position[pid] + count);
+            position[pid] += count;
+        }
+    }
+    return interleaved;
+}
+
+// Reparte numFrames entre los procesos (al menos un marco cada uno) por el metodo del mayor resto
+vector<int> allocateFrames(const vector<ProcessTrace> &processes, int numFrames, FrameAllocation allocation)
+{
+    size_t n = processes.size();
+    vector<double> weight(n, 1.0);
+    for (size_t pid = 0; pid < n; pid++)
+    {
+        if (allocation == FrameAllocation::Proportional) weight[pid] = (double)processes[pid].distinctPages;
+        else if (allocation == FrameAllocation::Priority) weight[pid] = (double)max(1, processes[pid].priority);
+    }
+
+    double totalWeight = 0;
+    for (double w : weight) totalWeight += w;
+    int spare = max(0, numFrames - (int)n); // Marcos que quedan tras el minimo de uno por proceso
+    vector<int> frames(n, 1);
+    vector<pair<double, size_t>> remainders;
+    int assigned = 0;
+    for (size_t pid = 0; pid < n; pid++)
+    {
+        double share = totalWeight > 0 ? spare * weight[pid] / totalWeight : 0;
+        frames[pid] += (int)share;
+        assigned += (int)share;
+        remainders.push_back(make_pair(share - (int)share, pid));
+    }
+    sort(remainders.rbegin(), remainders.rend());
+    for (int k = 0; k < spare - assigned; k++) frames[remainders[k].second]++;
+    return frames;
+}
+
+// Corre la politica sobre los tramos en orden; los fallos y escrituras de cada tramo se cargan
+// al proceso que estaba corriendo, aunque la pagina desalojada fuera de otro proceso
+template <typename Policy, typename... Args>
+void simulateSlices(const vector<MemoryReference> &trace, const vector<ProcessSlice> &slices, int numFrames,
+                    vector<ProcessResult> &results, Args &&...args)
+{
+    PageReplacementSimulator<Policy> simulator(numFrames, std::forward<Args>(args)...);
+    for (const ProcessSlice &slice : slices)
+    {
+        uint64_t faults = simulator.pageFaults;
+        uint64_t writeBacks = simulator.dirtyEvictions;
+        simulator.simulate(trace.data() + slice.begin, trace.data() + slice.end);
+        results[slice.pid].pageFaults += simulator.pageFaults - faults;
+        results[slice.pid].writeBacks += simulator.dirtyEvictions - writeBacks;
+    }
+    for (const MemoryMapping &mapping : simulator.frames)
+    {
+        results[mapping.page >> PROCESS_ID_SHIFT].frames++;
+    }
+}
+
+void simulateSlices(const string &algorithm, const vector<MemoryReference> &trace, const vector<ProcessSlice> &slices,
+                    int numFrames, vector<ProcessResult> &results)
+{
+    if (algorithm == "FIFO") simulateSlices<FIFOPolicy>(trace, slices, numFrames, results);
+    else if (algorithm == "LRU") simulateSlices<LRUPolicy>(trace, slices, numFrames, results);
+    else if (algorithm == "OPT") simulateSlices<OPTPolicy>(trace, slices, numFrames, results, trace.data(), buildNextUse(trace));
+    else if (algorithm == "CLOCK") simulateSlices<ClockPolicy<ClockVariant::SecondChance>>(trace, slices, numFrames, results);
+    else if (algorithm == "GCLOCK") simulateSlices<ClockPolicy<ClockVariant::GClock>>(trace, slices, numFrames, results);
+    else if (algorithm == "ESC") simulateSlices<ClockPolicy<ClockVariant::Enhanced>>(trace, slices, numFrames, results);
+    else if (algorithm == "ARC") simulateSlices<ARCPolicy>(trace, slices, numFrames, results);
+    else if (algorithm == "2Q") simulateSlices<TwoQPolicy>(trace, slices, numFrames, results);
+    else if (algorithm == "LIRS") simulateSlices<LIRSPolicy>(trace, slices, numFrames, results);
+    else failUnknownAlgorithm(algorithm);
+}
+
+// Reemplazo global: un solo conjunto de marcos para el trace intercalado
+vector<ProcessResult> simulateGlobalReplacement(const string &algorithm, const vector<ProcessTrace> &processes,
+                                                const vector<MemoryReference> &interleaved, const vector<ProcessSlice> &slices, int numFrames)
+{
+    vector<ProcessResult> results(processes.size());
+    simulateSlices(algorithm, interleaved, slices, numFrames, results);
+    return results;
+}
+
+// Reemplazo local: cada proceso solo desaloja sus propias paginas dentro de los marcos que le
+// tocaron, asi el intercalado no cambia sus resultados
+vector<ProcessResult> simulateLocalReplacement(const string &algorithm, const vector<ProcessTrace> &processes,
+                                               int numFrames, FrameAllocation allocation)
+{
+    vector<ProcessResult> results(processes.size());
+    vector<int> frames = allocateFrames(processes, numFrames, allocation);
+    for (size_t pid = 0; pid < processes.size(); pid++)
+    {
+        vector<ProcessSlice> whole(1, ProcessSlice{(int)pid, 0, processes[pid].trace.size()});
+        simulateSlices(algorithm, processes[pid].trace, whole, frames[pid], results);
+        results[pid].frames = frames[pid];
+    }
+    return results;
+}
+
+void printProcessTable(const vector<ProcessTrace> &processes, const vector<ProcessResult> &results)
+{
+    ProcessResult total;
+    std::cout << "+-----------------------------------------------------------+" << std::endl;
+    std::cout << "| " << std::setw(20) << std::left << "Proceso" << "| " << std::setw(8) << "Marcos" << "| "
+              << std::setw(12) << "Page Faults" << "| " << std::setw(12) << "Escrituras" << "|" << std::endl;
+    std::cout << "+-----------------------------------------------------------+" << std::endl;
+    for (size_t pid = 0; pid < processes.size(); pid++)
+    {
+        std::cout << "| " << std::setw(20) << std::left << processes[pid].name << "| " << std::setw(8) << results[pid].frames << "| "
+                  << std::setw(12) << results[pid].pageFaults << "| " << std::setw(12) << results[pid].writeBacks << "|" << std::endl;
+        total.frames += results[pid].frames;
+        total.pageFaults += results[pid].pageFaults;
+        total.writeBacks += results[pid].writeBacks;
+    }
+    std::cout << "| " << std::setw(20) << std::left << "Total" << "| " << std::setw(8) << total.frames << "| "
+              << std::setw(12) << total.pageFaults << "| " << std::setw(12) << total.writeBacks << "|" << std::endl;
+    std::cout << "+-----------------------------------------------------------+" << std::endl;
+}
+
+// Asignacion variable de marcos: el conjunto residente crece y se achica segun el comportamiento
+// del proceso en vez de fijar numFrames. Se muestrea su tamaño cada RESIDENT_SAMPLE_INTERVAL referencias
+const uint64_t RESIDENT_SAMPLE_INTERVAL = 1000;
+
+struct ResidentSetStats
+{
+    uint64_t pageFaults = 0;
+    uint64_t writeBacks = 0;
+    uint64_t references = 0;
+    uint64_t residentSum = 0;
+    size_t maxResident = 0;
+    vector<pair<uint64_t, size_t>> timeline; // (referencia, paginas residentes)
+
+    void record(size_t resident)
+    {
+        references++;
+        residentSum += resident;
+        maxResident = max(maxResident, resident);
+        if (references % RESIDENT_SAMPLE_INTERVAL == 0) timeline.push_back(make_pair(references, resident));
+    }
+
+    double averageResident() const
+    {
+        return references == 0 ? 0.0 : (double)residentSum / references;
+    }
+};
+
+// Working set de ventana delta: antes de la referencia t estan residentes las paginas usadas en
+// [t - delta, t - 1]. Un anillo guarda las ultimas delta paginas y cada pagina cuenta cuantas veces
+// aparece en el; al llegar a cero sale de memoria
+struct WorkingSetSimulator
+{
+    struct WindowPage
+    {
+        uint32_t count = 0;
+        bool dirty = false;
+    };
+
+    size_t delta;
+    vector<uint64_t> window;
+    FlatPageMap<WindowPage> resident; // A lo sumo delta paginas: se reserva al construir
+    uint64_t now = 0;
+    ResidentSetStats stats;
+
+    explicit WorkingSetSimulator(size_t windowSize) : delta(max<size_t>(1, windowSize)), window(delta)
+    {
+        resident.reserve(delta + 1);
+    }
+
+    void simulate(const MemoryReference *begin, const MemoryReference *end)
+    {
+        for (const MemoryReference *reference = begin; reference != end; reference++)
+        {
+            WindowPage &page = resident[reference->page];
+            if (page.count == 0) stats.pageFaults++;
+            page.count++;
+            page.dirty = page.dirty || reference->operation == 'W';
+
+            // La referencia t - delta sale de la ventana y ocupa su lugar la actual
+            size_t slot = now % delta;
+            uint64_t expiring = window[slot];
+            window[slot] = reference->page;
+            if (now >= delta)
+            {
+                WindowPage *expired = resident.find(expiring);
+                if (--expired->count == 0)
+                {
+                    stats.writeBacks += expired->dirty;
+                    resident.erase(expiring);
+                }
+            }
+            now++;
+            stats.record(resident.size());
+        }
+    }
+};
+
+// PFF (Chu y Opderbeck): en cada fallo, si pasaron mas de threshold referencias desde el fallo
+// anterior el proceso tiene marcos de sobra y se liberan las paginas no usadas desde ese fallo;
+// si no, el conjunto residente crece con la pagina nueva
+struct PFFSimulator
+{
+    uint64_t threshold;
+    RadixPageTable pageTable;  // El marco de la PTE es la posicion de la pagina en resident
+    vector<uint64_t> resident;
+    vector<uint64_t> lastUse;  // Ultima referencia a cada pagina residente
+    uint64_t now = 0;
+    uint64_t lastFault = 0;
+    ResidentSetStats stats;
+
+    explicit PFFSimulator(uint64_t interval) : threshold(interval) {}
+
+    void simulate(const MemoryReference *begin, const MemoryReference *end)
+    {
+        for (const MemoryReference *reference = begin; reference != end; reference++)
+        {
+            bool write = (reference->operation == 'W');
+            PageTableEntry *entry = pageTable.find(reference->page);
+            if (entry != nullptr && entry->present())
+            {
+                entry->touch(write);
+                lastUse[entry->frame()] = now;
+            }
+            else
+            {
+                stats.pageFaults++;
+                if (stats.pageFaults > 1 && now - lastFault > threshold) shrink();
+                lastFault = now;
+                pageTable.entry(reference->page).map(resident.size(), write);
+                resident.push_back(reference->page);
+                lastUse.push_back(now);
+            }
+            now++;
+            stats.record(resident.size());
+        }
+    }
+
+    // Libera las paginas que no se usaron desde el fallo anterior
+    void shrink()
+    {
+        for (size_t slot = 0; slot < resident.size();)
+        {
+            if (lastUse[slot] >= lastFault)
+            {
+                slot++;
+                continue;
+            }
+            PageTableEntry &entry = pageTable.entry(resident[slot]);
+            stats.writeBacks += entry.dirty();
+            entry.unmap();
+
+            // La ultima pagina pasa al lugar liberado
+            resident[slot] = resident.back();
+            lastUse[slot] = lastUse.back();
+            resident.pop_back();
+            lastUse.pop_back();
+            if (slot < resident.size())
+            {
+                PageTableEntry &moved = pageTable.entry(resident[slot]);
+                moved.map(slot, moved.dirty());
+            }
+        }
+    }
+};
+
+// Resultado de una corrida de asignacion variable, para la tabla y el CSV
+struct ResidentSetRun
+{
+    string policy; // "WS" o "PFF"
+    uint64_t parameter; // Ventana delta o umbral entre fallos
+    ResidentSetStats stats;
+};
+
+void printResidentSetTable(const ResidentSetRun &run)
+{
+    std::cout << "+------------------------------------------------+" << std::endl;
+    std::cout << "| Page Faults:                       |" << std::setw(10) << std::left << run.stats.pageFaults << " |" << std::endl;
+    std::cout << "| Escrituras a disco:                |" << std::setw(10) << std::left << run.stats.writeBacks << " |" << std::endl;
+    std::cout << "| Paginas residentes (promedio):     |" << std::setw(10) << std::left << run.stats.averageResident() << " |" << std::endl;
+    std::cout << "| Paginas residentes (maximo):       |" << std::setw(10) << std::left << run.stats.maxResident << " |" << std::endl;
+    std::cout << "+------------------------------------------------+" << std::endl;
+}
+
+// Guarda la evolucion del conjunto residente de todas las corridas en un CSV
+void saveResidentSetTimeline(const vector<ResidentSetRun> &runs, const string &filename)
+{
+    ofstream file(filename);
+
+    file << "policy,parameter,reference,resident_pages" << endl;
+    for (const ResidentSetRun &run : runs)
+    {
+        for (const auto &sample : run.stats.timeline)
+        {
+            file << run.policy << "," << run.parameter << "," << sample.first << "," << sample.second << "\n";
+        }
+    }
+
+    file.close();
+}
+
+// Latencias del modelo de costo, en nanosegundos
+struct CostModel
+{
+    double memoryAccessNs = 100.0;    // Acceso a memoria principal (hit)
+    double faultServiceNs = 8000000.0; // Atender un page fault: leer la pagina del disco
+    double writeBackNs = 8000000.0;    // Escribir a disco una pagina sucia desalojada
+    double tlbLookupNs = 1.0;          // Consulta a la TLB L1
+    double l2TlbLookupNs = 5.0;        // Consulta a la TLB L2 tras fallar en L1
+    double pageWalkNs = 100.0;         // Recorrer la tabla de paginas tras fallar en la TLB
+    double prefetchReadNs = 100000.0;  // Leer una pagina extra junto a la del fallo (sin seek)
+};
+
+// EAT por referencia: todo acceso paga la memoria; los fallos pagan ademas la lectura del
+// disco y las paginas sucias desalojadas su escritura. Si el job simulo una TLB se suma el
+// costo de traduccion: consulta a L1, consulta a L2 en los fallos de L1 y recorrido de la tabla.
+// Cada pagina traida por readahead paga su transferencia
+double effectiveAccessTime(const CostModel &cost, uint64_t references, const SimulationJob &job)
+{
+    if (references == 0) return 0.0;
+    double faultRate = (double)job.pageFaults / references;
+    double writeBackRate = (double)job.writeBacks / references;
+    double prefetchRate = (double)job.prefetches / references;
+    double eat = cost.memoryAccessNs + faultRate * cost.faultServiceNs + writeBackRate * cost.writeBackNs +
+                 prefetchRate * cost.prefetchReadNs;
+    if (job.tlb.enabled())
+    {
+        double l1MissRate = (double)(references - job.tlbL1Hits) / references;
+        double walkRate = (double)job.tlbWalks / references;
+        eat += cost.tlbLookupNs + walkRate * cost.pageWalkNs;
+        if (job.tlb.l2.entries > 0) eat += l1MissRate * cost.l2TlbLookupNs;
+    }
+    return eat;
+}
+
+// Imprime la tabla resumen a partir de los contadores ya calculados; eat en ns por referencia
+void printSummaryTable(uint64_t pageFaults, uint64_t replace, uint64_t writesToDisk, uint64_t framesUsed, int numFrames,
+                       double eat)
+{
+    std::cout << "+------------------------------------------------+" << std::endl;
+    std::cout << "| Page Faults:                       |" << std::setw(10) << std::left << pageFaults << " |" << std::endl;
+    std::cout << "| Reemplazos realizados:             |" << std::setw(10) << std::left << replace << " |" << std::endl;
+    std::cout << "| Escrituras a disco:                |" << std::setw(10) << std::left << writesToDisk << " |" << std::endl;
+    std::cout << "| Marcos ocupados:                   |" << std::setw(10) << std::left << (to_string(framesUsed) + "/" + to_string(numFrames)) << " |" << std::endl;
+    std::cout << "| EAT (tiempo de acceso a memoria):  |" << std::setw(10) << std::left << eat << " |" << std::endl;
+    std::cout << "+------------------------------------------------+" << std::endl;
+}
+
+// Filas de la TLB: tasa de aciertos por nivel sobre las traducciones que llegan a cada nivel
+void printTLBSummary(const SimulationJob &job, uint64_t references)
+{
+    if (!job.tlb.enabled() || references == 0) return;
+    double l1HitRate = 100.0 * job.tlbL1Hits / references;
+    std::cout << "| TLB L1 hit rate (%):               |" << std::setw(10) << std::left << l1HitRate << " |" << std::endl;
+    if (job.tlb.l2.entries > 0)
+    {
+        uint64_t l1Misses = references - job.tlbL1Hits;
+        double l2HitRate = l1Misses == 0 ? 100.0 : 100.0 * job.tlbL2Hits / l1Misses;
+        std::cout << "| TLB L2 hit rate (%):               |" << std::setw(10) << std::left << l2HitRate << " |" << std::endl;
+    }
+    std::cout << "| Recorridos de tabla de paginas:    |" << std::setw(10) << std::left << job.tlbWalks << " |" << std::endl;
+    std::cout << "+------------------------------------------------+" << std::endl;
+}
+
+// Filas del readahead: paginas traidas, usadas y desalojadas sin usar
+void printPrefetchSummary(const SimulationJob &job)
+{
+    if (!usesPrefetch(job)) return;
+    uint64_t unused = job.prefetches - job.usefulPrefetches - job.wastedPrefetches;
+    std::cout << "| Paginas traidas por readahead:     |" << std::setw(10) << std::left << job.prefetches << " |" << std::endl;
+    std::cout << "| Readahead util:                    |" << std::setw(10) << std::left << job.usefulPrefetches << " |" << std::endl;
+    std::cout << "| Readahead desperdiciado:           |" << std::setw(10) << std::left << job.wastedPrefetches << " |" << std::endl;
+    std::cout << "| Readahead sin usar al terminar:    |" << std::setw(10) << std::left << unused << " |" << std::endl;
+    std::cout << "+------------------------------------------------+" << std::endl;
+}
+
+
+// Mapa final de marcos a paginas; solo existe si el job lo guardo (--frame-map)
+void printFrameMap(const SimulationJob &job)
+{
+    if (!job.keepFrameMap) return;
+    std::cout << "| Marco | Pagina                         | Sucia |" << std::endl;
+    for (size_t frame = 0; frame < job.frameMap.size(); frame++)
+    {
+        std::ostringstream page;
+        page << "0x" << std::hex << job.frameMap[frame].first;
+        std::cout << "| " << std::setw(5) << std::left << frame << " | " << std::setw(30) << std::left << page.str()
+                  << " | " << std::setw(5) << std::left << (job.frameMap[frame].second ? "si" : "no") << " |" << std::endl;
+    }
+    std::cout << "+------------------------------------------------+" << std::endl;
+}
+
+// Reporte de la corrida para dashboards: tiempos por fase y contadores de cada simulacion
+struct RunReport
+{
+    string trace;
+    uint64_t references = 0;
+    uint64_t pageSizeBytes = 0;
+    vector<pair<string, double>> phases; // (fase, segundos)
+
+    template <typename Task>
+    void timePhase(const string &phase, Task task)
+    {
+        auto start = chrono::steady_clock::now();
+        task();
+        phases.push_back(make_pair(phase, secondsSince(start)));
+    }
+};
+
+string jsonString(const string &text)
+{
+    string quoted = "\"";
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\') quoted += '\\';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+// Contadores de una simulacion como (nombre, valor); JSON y CSV emiten exactamente esta lista.
+// Un valor vacio no aplica (null en JSON): las filas LRU leidas de la curva no tienen tiempo propio,
+// su costo esta en la fase stackDistance
+vector<pair<string, string>> simulationCounters(const SimulationJob &job, uint64_t references, const CostModel &cost)
+{
+    double perSecond = job.seconds > 0 ? references / job.seconds : 0.0;
+    vector<pair<string, string>> counters;
+    auto add = [&](const string &name, auto value)
+    {
+        ostringstream text;
+        text << value;
+        counters.push_back(make_pair(name, text.str()));
+    };
+    if (job.fromLRUCurve)
+    {
+        counters.push_back(make_pair("seconds", ""));
+        counters.push_back(make_pair("references_per_second", ""));
+    }
+    else
+    {
+        add("seconds", job.seconds);
+        add("references_per_second", perSecond);
+    }
+    add("hits", references - job.pageFaults);
+    add("misses", job.pageFaults);
+    add("evictions", job.replacements);
+    add("dirty_evictions", job.writeBacks);
+    add("frames_used", job.framesUsed);
+    add("page_table_lookups", job.pageTableLookups);
+    add("tlb_l1_hits", job.tlbL1Hits);
+    add("tlb_l2_hits", job.tlbL2Hits);
+    add("tlb_walks", job.tlbWalks);
+    add("prefetches", job.prefetches);
+    add("useful_prefetches", job.usefulPrefetches);
+    add("wasted_prefetches", job.wastedPrefetches);
+    add("eat_ns", effectiveAccessTime(cost, references, job));
+    return counters;
+}
+
+void saveRunReportJSON(const RunReport &report, const vector<SimulationJob> &jobs, const CostModel &cost, const string &filename)
+{
+    ofstream file(filename);
+    uint64_t references = report.references;
+
+    file << "{\n";
+    file << "  \"trace\": " << jsonString(report.trace) << ",\n";
+    file << "  \"references\": " << references << ",\n";
+    file << "  \"page_size_bytes\": " << report.pageSizeBytes << ",\n";
+    file << "  \"phases\": [";
+    for (size_t i = 0; i < report.phases.size(); i++)
+    {
+        file << (i ? "," : "") << "\n    {\"name\": " << jsonString(report.phases[i].first) << ", \"seconds\": " << report.phases[i].second << "}";
+    }
+    file << "\n  ],\n";
+    file << "  \"simulations\": [";
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        file << (i ? "," : "") << "\n    {\"algorithm\": " << jsonString(jobs[i].algorithm) << ", \"frames\": " << jobs[i].numFrames;
+        for (const auto &counter : simulationCounters(jobs[i], references, cost))
+        {
+            file << ", " << jsonString(counter.first) << ": " << (counter.second.empty() ? "null" : counter.second);
+        }
+        file << "}";
+    }
+    file << "\n  ]\n}\n";
+
+    file.close();
+}
+
+// Una fila por fase y una por simulacion; las columnas que no aplican quedan vacias. Los nombres de
+// las columnas de contadores salen de simulationCounters con un job vacio
+void saveRunReportCSV(const RunReport &report, const vector<SimulationJob> &jobs, const CostModel &cost, const string &filename)
+{
+    ofstream file(filename);
+    uint64_t references = report.references;
+    vector<pair<string, string>> columns = simulationCounters(SimulationJob("", 0), references, cost);
+
+    file << "kind,name,frames,references";
+    for (const auto &column : columns) file << "," << column.first;
+    file << endl;
+    for (const auto &phase : report.phases)
+    {
+        file << "phase," << phase.first << ",," << references << "," << phase.second;
+        for (size_t k = 1; k < columns.size(); k++) file << ",";
+        file << "\n";
+    }
+    for (const SimulationJob &job : jobs)
+    {
+        file << "simulation," << job.algorithm << "," << job.numFrames << "," << references;
+        for (const auto &counter : simulationCounters(job, references, cost)) file << "," << counter.second;
+        file << "\n";
+    }
+
+    file.close();
+}
+
+// Benchmark de los motores: mide carga, pre-passes y cada politica sobre traces sinteticos de
+// tamaño creciente y sobre los traces reales que existan, sin pasar por el menu interactivo
+struct BenchmarkResult
+{
+    string trace;
+    string phase;
+    size_t references;
+    int frames; // 0 si la fase no depende de la cantidad de marcos
+    double seconds;
+    size_t phaseMemoryKB; // Pico de memoria residente de la fase por encima de la de antes de empezar
+};
+
+// Campo de memoria de /proc/self/status en KiB ("VmRSS:" actual, "VmHWM:" pico); 0 fuera de Linux
+size_t processMemoryKB(const string &field)
+{
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line))
+    {
+        if (line.compare(0, field.size(), field) == 0) return strtoull(line.c_str() + field.size(), nullptr, 10);
+    }
+    return 0;
+}
+
+// Reinicia el pico de memoria residente del proceso (Linux >= 4.0); false si no se puede
+bool resetPeakMemory()
+{
+    ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+    clearRefs.close();
+    return !clearRefs.fail();
+}
+
+template <typename Task>
+void timeBenchmarkPhase(vector<BenchmarkResult> &results, const string &trace, const string &phase, size_t references,
+                        int frames, Task task)
+{
+    // El pico de la fase se mide desde cero; si no se puede reiniciar queda la memoria al terminar
+    size_t before = processMemoryKB("VmRSS:");
+    bool peakReset = resetPeakMemory();
+    auto start = chrono::steady_clock::now();
+    task();
+    double seconds = secondsSince(start);
+    size_t after = processMemoryKB(peakReset ? "VmHWM:" : "VmRSS:");
+    results.push_back(BenchmarkResult{trace, phase, references, frames, seconds, after > before ? after - before : 0});
+}
+
+// Fases sobre un trace ya cargado: pre-passes y cada politica con cada cantidad de marcos
+void benchmarkTrace(vector<BenchmarkResult> &results, const string &name, const vector<MemoryReference> &memoryTrace,
+                    const vector<int> &frameCounts, const vector<string> &algorithms)
+{
+    size_t n = memoryTrace.size();
+    vector<size_t> nextUse;
+    timeBenchmarkPhase(results, name, "buildNextUse", n, 0, [&]() { nextUse = buildNextUse(memoryTrace); });
+    timeBenchmarkPhase(results, name, "stackDistance", n, 0, [&]()
+    {
+        StackDistanceAnalyzer analyzer;
+        analyzer.simulate(memoryTrace.data(), memoryTrace.data() + n);
+        LRUMissRatioCurve curve(analyzer);
+    });
+    for (int frames : frameCounts)
+    {
+        for (const string &algorithm : algorithms)
+        {
+            timeBenchmarkPhase(results, name, algorithm, n, frames, [&]()
+            {
+                SimulationJob job(algorithm, frames);
+                runSimulationJob(memoryTrace, job, nextUse, nullptr);
+            });
+        }
+    }
+}
+
+// Los traces sinteticos usan la carga elegida con --generate (zipf por defecto) con cada largo
+void runBenchmark(const vector<size_t> &sizes, const vector<int> &frameCounts, const vector<string> &algorithms,
+                  WorkloadConfig workload, int numThreads)
+{
+    vector<BenchmarkResult> results;
+    const string textFile = "benchmark.trace";
+    const string binaryFile = "benchmark.trace.bin";
+
+    for (size_t size : sizes)
+    {
+        string name = "sintetico-" + to_string(size);
+        workload.length = size;
+        vector<MemoryReference> memoryTrace;
+        timeBenchmarkPhase(results, name, "generate", size, 0, [&]() { memoryTrace = generateMemoryTrace(workload); });
+        saveGeneratedTrace(workload, textFile, false);
+
+        uint64_t converted = 0;
+        timeBenchmarkPhase(results, name, "convertTraceToBinary", size, 0, [&]() { convertTraceToBinary(textFile, binaryFile, converted); });
+        timeBenchmarkPhase(results, name, "loadMemoryTrace (texto)", size, 0, [&]()
+        {
+            vector<MemoryReference> loaded;
+            loadMemoryTrace(textFile, loaded, -1, numThreads);
+        });
+        timeBenchmarkPhase(results, name, "loadMemoryTrace (binario)", size, 0, [&]()
+        {
+            vector<MemoryReference> loaded;
+            loadMemoryTrace(binaryFile, loaded, -1, numThreads);
+        });
+        benchmarkTrace(results, name, memoryTrace, frameCounts, algorithms);
+    }
+    remove(textFile.c_str());
+    remove(binaryFile.c_str());
+
+    for (const string &file : {string("gcc.trace"), string("bzip.trace")})
+    {
+        vector<MemoryReference> memoryTrace;
+        timeBenchmarkPhase(results, file, "loadMemoryTrace", 0, 0, [&]() { loadMemoryTrace(file, memoryTrace, -1, numThreads); });
+        if (memoryTrace.empty())
+        {
+            results.pop_back();
+            continue;
+        }
+        results.back().references = memoryTrace.size();
+        benchmarkTrace(results, file, memoryTrace, frameCounts, algorithms);
+    }
+
+    cout << std::setw(22) << std::left << "Trace" << std::setw(28) << "Fase" << std::setw(8) << "Marcos" << std::setw(12) << "Segundos"
+         << std::setw(12) << "Mref/s" << std::setw(10) << "ns/ref" << "MiB fase" << endl;
+    ofstream csv("benchmark.csv");
+    csv << "trace,phase,references,frames,seconds,refs_per_second,ns_per_reference,phase_peak_memory_kb" << endl;
+    for (const BenchmarkResult &result : results)
+    {
+        double perSecond = result.seconds > 0 ? result.references / result.seconds : 0.0;
+        double nsPerReference = result.references > 0 ? result.seconds * 1e9 / result.references : 0.0;
+        cout << std::setw(22) << std::left << result.trace << std::setw(28) << result.phase << std::setw(8)
+             << (result.frames > 0 ? to_string(result.frames) : "-") << std::setw(12) << std::fixed << std::setprecision(4)
+             << result.seconds << std::setw(12) << std::setprecision(2) << perSecond / 1e6 << std::setw(10) << nsPerReference
+             << result.phaseMemoryKB / 1024.0 << endl;
+        csv << result.trace << "," << result.phase << "," << result.references << "," << result.frames << "," << result.seconds << ","
+            << perSecond << "," << nsPerReference << "," << result.phaseMemoryKB << "\n";
+    }
+    cout.unsetf(ios::floatfield);
+    cout << std::setprecision(6);
+}
+
+int main(int argc, char *argv[])
+{
+    bool streaming = false;      // FIFO y LRU sin cargar el trace completo
+    bool saveLRUCurve = false;   // Guardar la curva de fallos LRU completa en CSV
+    int numThreads = max(1u, thread::hardware_concurrency()); // Hilos del barrido de simulaciones
+    vector<string> algorithms = {"FIFO", "LRU", "OPT"}; // Filas de la tabla por cada cantidad de frames
+    vector<int> frames = {10, 50, 100};  // Cantidades de frames del barrido, --frames 10,50,100
+    CostModel cost; // Latencias para el EAT
+    TLBHierarchyConfig tlbConfig; // Sin TLB salvo que se pida con --tlb
+    PrefetchConfig prefetchConfig; // Sin readahead salvo que se pida con --prefetch
+    bool frameMap = false;         // --frame-map: imprime el mapa de marcos final de cada simulacion
+    int pageSizeBits = PAGE_OFFSET_BITS; // Tamaño de pagina simulado, --page-size
+    vector<ProcessTrace> processes;      // Modo multiproceso, --processes gcc.trace,bzip.trace
+    size_t quantum = 1000;               // Referencias por turno del planificador
+    bool globalReplacement = true;
+    vector<int> priorities;              // --priorities 3,1: se aplican a los procesos al terminar de leer los argumentos
+    FrameAllocation allocation = FrameAllocation::Fixed;
+    vector<uint64_t> workingSetWindows;  // --working-set 1000,5000: ventanas delta
+    vector<uint64_t> pffThresholds;      // --pff 100,500: referencias entre fallos
+    bool saveResidentSet = false;        // --rss-csv: evolucion del conjunto residente
+    bool benchmark = false;              // --bench: mide los motores y termina
+    vector<size_t> benchmarkSizes = {1000000, 10000000};
+    vector<int> benchmarkFrames = {10, 100, 1000};
+    WorkloadConfig workload;             // --generate: carga sintetica en lugar de gcc.trace
+    bool generateWorkload = false;
+    string savedTrace;                   // --save-trace / --save-trace-bin: solo escribir la carga
+    bool savedTraceBinary = false;
+    string reportJSON;                   // --report-json / --report-csv: reporte para dashboards
+    string reportCSV;
+    for (int arg = 1; arg < argc; arg++)
+    {
+        if (string(argv[arg]) == "--stream") streaming = true;
+        if (string(argv[arg]) == "--mrc") saveLRUCurve = true;
+        if (string(argv[arg]) == "--threads" && arg + 1 < argc) numThreads = max(1, atoi(argv[++arg]));
+        if (string(argv[arg]) == "--mem-ns" && arg + 1 < argc) cost.memoryAccessNs = atof(argv[++arg]);
+        if (string(argv[arg]) == "--fault-ns" && arg + 1 < argc) cost.faultServiceNs = atof(argv[++arg]);
+        if (string(argv[arg]) == "--writeback-ns" && arg + 1 < argc) cost.writeBackNs = atof(argv[++arg]);
+        if ((string(argv[arg]) == "--tlb" || string(argv[arg]) == "--tlb2") && arg + 1 < argc)
+        {
+            TLBConfig &level = string(argv[arg]) == "--tlb2" ? tlbConfig.l2 : tlbConfig.l1;
+            if (!parseTLBConfig(argv[++arg], level))
+            {
+                cerr << "TLB invalida: " << argv[arg] << " (ENTRADAS[:VIAS[:LRU|FIFO|RANDOM]] con ENTRADAS multiplo de VIAS, por ejemplo 64:4:LRU)" << endl;
+                return 1;
+            }
+        }
+        if (string(argv[arg]) == "--tlb-ns" && arg + 1 < argc) cost.tlbLookupNs = atof(argv[++arg]);
+        if (string(argv[arg]) == "--tlb2-ns" && arg + 1 < argc) cost.l2TlbLookupNs = atof(argv[++arg]);
+        if (string(argv[arg]) == "--walk-ns" && arg + 1 < argc) cost.pageWalkNs = atof(argv[++arg]);
+        if (string(argv[arg]) == "--prefetch" && arg + 1 < argc)
+        {
+            if (!parsePrefetchConfig(argv[++arg], prefetchConfig))
+            {
+                cerr << "Readahead invalido: " << argv[arg] << " (fixed|stride|adaptive[:VENTANA[:MAXIMO]], por ejemplo adaptive:4:32)" << endl;
+                return 1;
+            }
+        }
+        if (string(argv[arg]) == "--frame-map") frameMap = true;
+        if (string(argv[arg]) == "--prefetch-ns" && arg + 1 < argc) cost.prefetchReadNs = atof(argv[++arg]);
+        if (string(argv[arg]) == "--page-size" && arg + 1 < argc)
+        {
+            pageSizeBits = parsePageSize(argv[++arg]);
+            if (pageSizeBits < 0)
+            {
+                cerr << "Tamaño de pagina invalido: " << argv[arg] << " (por ejemplo 4K, 16K, 64K o 2M)" << endl;
+                return 1;
+            }
+        }
+        if (string(argv[arg]) == "--processes" && arg + 1 < argc)
+        {
+            istringstream list(argv[++arg]);
+            string name;
+            while (getline(list, name, ','))
+            {
+                processes.push_back(ProcessTrace());
+                processes.back().name = name;
+            }
+        }
+        if (string(argv[arg]) == "--priorities" && arg + 1 < argc)
+        {
+            // Una prioridad por proceso, en el orden de --processes
+            priorities.clear();
+            istringstream list(argv[++arg]);
+            string value;
+            while (getline(list, value, ',')) priorities.push_back(atoi(value.c_str()));
+        }
+        if ((string(argv[arg]) == "--working-set" || string(argv[arg]) == "--pff") && arg + 1 < argc)
+        {
+            vector<uint64_t> &values = string(argv[arg]) == "--pff" ? pffThresholds : workingSetWindows;
+            istringstream list(argv[++arg]);
+            string value;
+            while (getline(list, value, ',')) values.push_back(max(1ULL, strtoull(value.c_str(), nullptr, 10)));
+        }
+        if (string(argv[arg]) == "--rss-csv") saveResidentSet = true;
+        if (string(argv[arg]) == "--generate" && arg + 1 < argc)
+        {
+            generateWorkload = true;
+            if (!parseWorkloadKind(argv[++arg], workload.kind))
+            {
+                cerr << "Carga desconocida: " << argv[arg] << " (zipf, uniform, scan, loop o phase)" << endl;
+                return 1;
+            }
+        }
+        if (string(argv[arg]) == "--footprint" && arg + 1 < argc) workload.footprint = strtoull(argv[++arg], nullptr, 10);
+        if (string(argv[arg]) == "--length" && arg + 1 < argc) workload.length = strtoull(argv[++arg], nullptr, 10);
+        if (string(argv[arg]) == "--write-ratio" && arg + 1 < argc) workload.writeRatio = atof(argv[++arg]);
+        if (string(argv[arg]) == "--seed" && arg + 1 < argc) workload.seed = strtoull(argv[++arg], nullptr, 10);
+        if (string(argv[arg]) == "--zipf-theta" && arg + 1 < argc) workload.zipfTheta = atof(argv[++arg]);
+        if (string(argv[arg]) == "--phase-length" && arg + 1 < argc) workload.phaseLength = strtoull(argv[++arg], nullptr, 10);
+        if ((string(argv[arg]) == "--save-trace" || string(argv[arg]) == "--save-trace-bin") && arg + 1 < argc)
+        {
+            savedTraceBinary = string(argv[arg]) == "--save-trace-bin";
+            savedTrace = argv[++arg];
+        }
+        if (string(argv[arg]) == "--bench") benchmark = true;
+        if (string(argv[arg]) == "--report-json" && arg + 1 < argc) reportJSON = argv[++arg];
+        if (string(argv[arg]) == "--report-csv" && arg + 1 < argc) reportCSV = argv[++arg];
+        if ((string(argv[arg]) == "--bench-sizes" || string(argv[arg]) == "--bench-frames") && arg + 1 < argc)
+        {
+            bool sizes = string(argv[arg]) == "--bench-sizes";
+            if (sizes) benchmarkSizes.clear(); else benchmarkFrames.clear();
+            istringstream list(argv[++arg]);
+            string value;
+            while (getline(list, value, ','))
+            {
+                if (sizes) benchmarkSizes.push_back(strtoull(value.c_str(), nullptr, 10));
+                else benchmarkFrames.push_back(min<int>(max(1, atoi(value.c_str())), PageTableEntry::FRAME_MASK + 1));
+            }
+        }
+        if (string(argv[arg]) == "--frames" && arg + 1 < argc)
+        {
+            // Lista separada por comas; cada valor cabe en el campo de marco de la PTE
+            frames.clear();
+            istringstream list(argv[++arg]);
+            string value;
+            while (getline(list, value, ','))
+            {
+                int count;
+                if (!parsePositiveInt(value, count) || (uint32_t)count > PageTableEntry::FRAME_MASK + 1)
+                {
+                    cerr << "Cantidad de frames invalida: " << value << " (entero entre 1 y " << PageTableEntry::FRAME_MASK + 1 << ")" << endl;
+                    return 1;
+                }
+                frames.push_back(count);
+            }
+            if (frames.empty())
+            {
+                cerr << "--frames necesita al menos una cantidad" << endl;
+                return 1;
+            }
+        }
+        if (string(argv[arg]) == "--quantum" && arg + 1 < argc) quantum = max(1, atoi(argv[++arg]));
+        if (string(argv[arg]) == "--replacement" && arg + 1 < argc)
+        {
+            string name = argv[++arg];
+            if (name != "global" && name != "local")
+            {
+                cerr << "Reemplazo desconocido: " << name << " (global o local)" << endl;
+                return 1;
+            }
+            globalReplacement = name == "global";
+        }
+        if (string(argv[arg]) == "--allocation" && arg + 1 < argc)
+        {
+            string name = argv[++arg];
+            if (name == "fixed") allocation = FrameAllocation::Fixed;
+            else if (name == "proportional") allocation = FrameAllocation::Proportional;
+            else if (name == "priority") allocation = FrameAllocation::Priority;
+            else
+            {
+                cerr << "Asignacion desconocida: " << name << " (fixed, proportional o priority)" << endl;
+                return 1;
+            }
+        }
+        if (string(argv[arg]) == "--algorithms" && arg + 1 < argc)
+        {
+            // Lista separada por comas, por ejemplo FIFO,LRU,OPT,CLOCK,GCLOCK,ESC
+            algorithms.clear();
+            istringstream list(argv[++arg]);
+            string name;
+            while (getline(list, name, ','))
+            {
+                if (!isKnownAlgorithm(name))
+                {
+                    cerr << "Algoritmo desconocido: " << name << " (FIFO, LRU, OPT, CLOCK, GCLOCK, ESC, ARC, 2Q o LIRS)" << endl;
+                    return 1;
+                }
+                algorithms.push_back(name);
+            }
+        }
+    }
+
+    if (argc == 4 && string(argv[1]) == "--convert")
+    {
+        // Convertir un trace de texto a binario: --convert gcc.trace gcc.trace.bin
+        uint64_t count = 0;
+        if (!convertTraceToBinary(argv[2], argv[3], count))
+        {
+            cerr << "No se pudo convertir " << argv[2] << " a " << argv[3] << endl;
+            return 1;
+        }
+        cout << "Se convirtieron " << count << " referencias a " << argv[3] << endl;
+        return 0;
+    }
+
+    if (benchmark)
+    {
+        // Sin --algorithms se miden todas las politicas
+        bool defaultAlgorithms = algorithms == vector<string>{"FIFO", "LRU", "OPT"};
+        if (defaultAlgorithms) algorithms = {"FIFO", "LRU", "OPT", "CLOCK", "GCLOCK", "ESC", "ARC", "2Q", "LIRS"};
+        runBenchmark(benchmarkSizes, benchmarkFrames, algorithms, workload, numThreads);
+        return 0;
+    }
+
+    if (generateWorkload && !savedTrace.empty())
+    {
+        // Solo escribir la carga sintetica: --generate zipf --length 1000000 --save-trace zipf.trace
+        if (!saveGeneratedTrace(workload, savedTrace, savedTraceBinary))
+        {
+            cerr << "No se pudo escribir " << savedTrace << endl;
+            return 1;
+        }
+        cout << "Se generaron " << workload.length << " referencias en " << savedTrace << endl;
+        return 0;
+    }
+
+    int numAddresses = -1; // Valor predeterminado para leer todo el archivo
+
+    // Preguntar al usuario si desea leer todo el archivo o ingresar la cantidad de direcciones
+    if (!generateWorkload)
+    {
+        char choice;
+        cout << "¿Desea leer todo el archivo gcc.trace? (y/n): ";
+        cin >> choice;
+
+        if (choice == 'n' || choice == 'N')
+        {
+            cout << "Ingrese la cantidad de direcciones a leer: ";
+            cin >> numAddresses;
+        }
+    }
+
+    if (!processes.empty())
+    {
+        // Multiproceso: los traces comparten los marcos de cada fila de la tabla
+        for (size_t pid = 0; pid < processes.size() && pid < priorities.size(); pid++) processes[pid].priority = priorities[pid];
+        if (!loadProcessTraces(processes, numAddresses, numThreads, pageSizeBits)) return 1;
+        vector<ProcessSlice> slices;
+        vector<MemoryReference> interleaved;
+        if (globalReplacement) interleaved = interleaveProcesses(processes, quantum, slices);
+
+        cout << "\n";
+        cout << "            Tabla Resumen Multiproceso           \n\n" << endl;
+        cout << "Reemplazo " << (globalReplacement ? "global" : "local") << ", quantum de " << quantum << " referencias\n" << endl;
+        for (int numFrames : frames)
+        {
+            for (const string &algorithm : algorithms)
+            {
+                vector<ProcessResult> results = globalReplacement
+                                                    ? simulateGlobalReplacement(algorithm, processes, interleaved, slices, numFrames)
+                                                    : simulateLocalReplacement(algorithm, processes, numFrames, allocation);
+                std::cout << "\033[1;36mSimulación " << algorithm << " para \033[0m" << numFrames << "\033[1;36m frames:\033[0m " << std::endl;
+                printProcessTable(processes, results);
+                cout << endl;
+            }
+        }
+        return 0;
+    }
+
+    // Cargar gcc.trace o generar la carga sintetica; en modo streaming solo OPT lo carga completo
+    RunReport report;
+    report.trace = generateWorkload ? "sintetico" : "gcc.trace";
+    report.pageSizeBytes = uint64_t(1) << pageSizeBits;
+    vector<MemoryReference> memoryTrace;
+    // Sin streaming el lector no se usa: no proyecta el archivo ni valida su encabezado
+    TraceReader reader = generateWorkload ? TraceReader(workload, pageSizeBits)
+                                          : TraceReader(streaming ? "gcc.trace" : "", numAddresses, pageSizeBits);
+    auto loadFullTrace = [&]()
+    {
+        if (generateWorkload) memoryTrace = generateMemoryTrace(workload);
+        else if (!loadMemoryTrace(memoryTrace, numAddresses, numThreads)) return false;
+        applyPageSize(memoryTrace.data(), memoryTrace.data() + memoryTrace.size(), pageSizeBits);
+        return true;
+    };
+    bool opened = false;
+    report.timePhase("load", [&]() { opened = streaming ? reader.isOpen() : loadFullTrace(); });
+    if (!opened)
+    {
+        cerr << "No se pudo abrir gcc.trace" << endl;
+        return 1;
+    }
+
+    // Simulaciones en el orden de la tabla: los algoritmos pedidos para cada cantidad de frames
+    vector<SimulationJob> jobs;
+    for (int numFrames : frames)
+    {
+        for (const string &algorithm : algorithms)
+        {
+            jobs.push_back(SimulationJob(algorithm, numFrames));
+            jobs.back().tlb = tlbConfig;
+            jobs.back().prefetch = prefetchConfig;
+            jobs.back().keepFrameMap = frameMap;
+        }
+    }
+
+    // Una sola pasada de distancias de pila da las filas LRU para todas las cantidades de frames.
+    // Solo se hace si alguna fila sale de la curva o se pidio guardarla
+    bool needsCurve = saveLRUCurve || any_of(jobs.begin(), jobs.end(), answeredByLRUCurve);
+    StackDistanceAnalyzer stackDistances;
+    if (needsCurve)
+    {
+        report.timePhase("stackDistance", [&]()
+        {
+            if (streaming)
+            {
+                streamMemoryTrace(reader, stackDistances);
+            }
+            else
+            {
+                stackDistances.simulate(memoryTrace.data(), memoryTrace.data() + memoryTrace.size());
+            }
+        });
+    }
+    LRUMissRatioCurve lruCurve(stackDistances);
+    if (saveLRUCurve)
+    {
+        saveMissRatioCurve(lruCurve, "lru_miss_ratio_curve.csv");
+    }
+
+    if (streaming)
+    {
+        // Los algoritmos en linea se simulan en streaming; OPT necesita conocer el futuro y
+        // materializa el trace
+        report.timePhase("streaming", [&]()
+        {
+            for (SimulationJob &job : jobs)
+            {
+                streamSimulationJob(reader, job);
+            }
+        });
+        if (any_of(jobs.begin(), jobs.end(), [](const SimulationJob &job) { return !job.done && job.algorithm == "OPT"; }))
+        {
+            report.timePhase("load (OPT)", [&]() { loadFullTrace(); });
+        }
+    }
+    // Referencias del trace: las del trace en memoria o, si en streaming no se cargo, las que
+    // entrego el lector en su ultima pasada
+    report.references = (streaming && memoryTrace.empty()) ? reader.references() : memoryTrace.size();
+    // Los jobs pendientes que no salen de la curva se simulan sobre el trace en memoria: tiene que
+    // estar completo o darian cero fallos
+    bool needsTrace = any_of(jobs.begin(), jobs.end(), [](const SimulationJob &job) { return !job.done && !answeredByLRUCurve(job); });
+    if (needsTrace && memoryTrace.size() != report.references)
+    {
+        cerr << "Error interno: hay simulaciones pendientes sin el trace cargado" << endl;
+        return 1;
+    }
+    // El pre-pass de OPT corre dentro del barrido: se descuenta de simulations para que las fases
+    // no se solapen y su suma sea el tiempo total
+    double nextUseSeconds = 0;
+    report.timePhase("simulations", [&]() { nextUseSeconds = runSimulationSweep(memoryTrace, jobs, numThreads, needsCurve ? &lruCurve : nullptr); });
+    report.phases.back().second -= nextUseSeconds;
+    report.phases.push_back(make_pair("nextUse", nextUseSeconds));
+    auto summaryStart = chrono::steady_clock::now();
+
+cout <<"\n";
+cout << "            Tabla Resumen           \n\n"<<endl;
+    cout << "Tamaño de pagina: " << ((uint64_t(1) << pageSizeBits) >> 10) << " KiB\n" << endl;
+    for (const SimulationJob &job : jobs)
+    {
+        if (job.algorithm == "FIFO")
+        {
+            std::cout << "\033[1;31mSimulación FIFO para \033[0m" << job.numFrames << "\033[1;31m frames:\033[0m " << std::endl;
+        }
+        else if (job.algorithm == "LRU")
+        {
+            std::cout << "\033[1;35mSimulación LRU para \033[0m" << job.numFrames << "\033[1;35m frames:\033[0m " << std::endl;
+        }
+        else if (job.algorithm == "OPT")
+        {
+            std::cout << " \033[1;33mSimulación OPT para \033[0m" << job.numFrames << "\033[1;33m frames:\033[0m " << std::endl;
+        }
+        else
+        {
+            std::cout << "\033[1;36mSimulación " << job.algorithm << " para \033[0m" << job.numFrames << "\033[1;36m frames:\033[0m " << std::endl;
+        }
+        double eat = effectiveAccessTime(cost, report.references, job);
+        printSummaryTable(job.pageFaults, job.replacements, job.writeBacks, job.framesUsed, job.numFrames, eat);
+        printTLBSummary(job, report.references);
+        printPrefetchSummary(job);
+        printFrameMap(job);
+        cout << endl;
+    }
+    report.phases.push_back(make_pair("summary", secondsSince(summaryStart)));
+
+    // Asignacion variable: working set y PFF no usan una cantidad fija de frames
+    vector<ResidentSetRun> residentRuns;
+    for (uint64_t window : workingSetWindows)
+    {
+        WorkingSetSimulator simulator(window);
+        report.timePhase("WS " + to_string(window), [&]()
+        {
+            if (streaming) streamMemoryTrace(reader, simulator);
+            else simulator.simulate(memoryTrace.data(), memoryTrace.data() + memoryTrace.size());
+        });
+        residentRuns.push_back(ResidentSetRun{"WS", window, simulator.stats});
+    }
+    for (uint64_t threshold : pffThresholds)
+    {
+        PFFSimulator simulator(threshold);
+        report.timePhase("PFF " + to_string(threshold), [&]()
+        {
+            if (streaming) streamMemoryTrace(reader, simulator);
+            else simulator.simulate(memoryTrace.data(), memoryTrace.data() + memoryTrace.size());
+        });
+        residentRuns.push_back(ResidentSetRun{"PFF", threshold, simulator.stats});
+    }
+    for (const ResidentSetRun &run : residentRuns)
+    {
+        if (run.policy == "WS")
+        {
+            std::cout << "\033[1;32mSimulación Working Set con ventana \033[0m" << run.parameter << "\033[1;32m referencias:\033[0m " << std::endl;
+        }
+        else
+        {
+            std::cout << "\033[1;32mSimulación PFF con umbral \033[0m" << run.parameter << "\033[1;32m referencias entre fallos:\033[0m " << std::endl;
+        }
+        printResidentSetTable(run);
+        cout << endl;
+    }
+    if (saveResidentSet && !residentRuns.empty())
+    {
+        saveResidentSetTimeline(residentRuns, "resident_set.csv");
+    }
+    if (!reportJSON.empty()) saveRunReportJSON(report, jobs, cost, reportJSON);
+    if (!reportCSV.empty()) saveRunReportCSV(report, jobs, cost, reportCSV);
+    return 0;
+}
@@ -89,6 +89,11 @@ int simulatePageReplacement(const vector<MemoryReference> &memoryTrace, const un
     int pageFaults = 0;
     deque<string> frameQueue;
 
+    // Resolver el algoritmo una sola vez, fuera del ciclo de referencias
+    enum { FIFO, LRU, OPT, NONE } policy = replacementAlgorithm == "FIFO" ? FIFO
+                                         : replacementAlgorithm == "LRU"  ? LRU
+                                         : replacementAlgorithm == "OPT"  ? OPT : NONE;
+
     // Tabla de marcos
     vector<vector<string>> frameTable;
 
@@ -108,19 +113,19 @@ int simulatePageReplacement(const vector<MemoryReference> &memoryTrace, const un
                 // La memoria está llena, se debe reemplazar una página
                 string pageToReplace;
 
-                if (replacementAlgorithm == "FIFO")
+                if (policy == FIFO)
                 {
                     // FIFO: Se reemplaza la página más antigua en la cola
                     pageToReplace = frameQueue.front();
                     frameQueue.pop_front();
                 }
-                else if (replacementAlgorithm == "LRU")
+                else if (policy == LRU)
                 {
                     // LRU: Se reemplaza la página que no ha sido utilizada recientemente
                     pageToReplace = frameQueue.back();
                     frameQueue.pop_back();
                 }
-                else if (replacementAlgorithm == "OPT")
+                else if (policy == OPT)
                 {
                     // OPT: Se reemplaza la página que se utilizará más adelante en el futuro
                     unordered_map<string, int> pageNextUse;